@@ -0,0 +1,42 @@
+/**
+ * @file aligned_allocator.h
+ * @brief Asignador para std::vector con memoria alineada (por defecto a línea de caché, 64 bytes)
+ */
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+template <class T, std::size_t Alignment = 64>
+struct AlignedAllocator
+{
+    static_assert(Alignment >= alignof(T), "alineamiento insuficiente para T");
+    static_assert((Alignment & (Alignment - 1)) == 0, "el alineamiento debe ser potencia de 2");
+
+    using value_type = T;
+
+    template <class U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept {}
+    template <class U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept {}
+
+    T *allocate(std::size_t n)
+    {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T *p, std::size_t) noexcept
+    {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+};
+
+template <class T, class U, std::size_t A>
+bool operator==(const AlignedAllocator<T, A> &, const AlignedAllocator<U, A> &) { return true; }
+template <class T, class U, std::size_t A>
+bool operator!=(const AlignedAllocator<T, A> &, const AlignedAllocator<U, A> &) { return false; }
@@ -0,0 +1,131 @@
+/**
+ * @file bench_eval.cpp
+ * @brief Evaluaciones por segundo de Sphere, Rosenbrock y Schwefel (dimensión 1024):
+ *        evaluación individuo a individuo frente a evaluación por lotes (simd_kernels.h)
+ *        para poblaciones 2^6, 2^10 y 2^14.
+ * compilar: c++ bench_eval.cpp -O2 -std=c++17 -pthread -o bench_eval
+ * ejecutar: ./bench_eval [-t <hilos>] [-d <segundos por medida>]
+ * Cada medida añade una fila al almacén por columnas bench_eval_<host> (result_store.h),
+ * que se exporta a CSV con ./resultados bench_eval_<host> -csv <fichero>.
+ */
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <iomanip>
+
+#include "thread_pool.h"
+#include "real_population.h"
+#include "result_rows.h"
+#include "result_store.h"
+#include "simd_kernels.h"
+
+using namespace std;
+
+static constexpr size_t INDIVIDUAL_SIZE = 1024;
+
+struct Problem
+{
+    const char *name;
+    double lower, upper;
+    double (*single)(const double *, size_t);
+    RowsKernel rows;
+};
+
+// ----------------------------------------------------
+// Repite la evaluación completa de la población hasta cubrir 'seconds' y
+// devuelve evaluaciones por segundo
+template <class F>
+double measure(size_t popSize, double seconds, F &&evalPop)
+{
+    evalPop(); // calentamiento
+    size_t rounds = 0;
+    auto t0 = chrono::steady_clock::now();
+    double elapsed = 0.0;
+    do
+    {
+        evalPop();
+        ++rounds;
+        elapsed = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    } while (elapsed < seconds);
+    return double(rounds * popSize) / elapsed;
+}
+
+int main(int argc, char **argv)
+{
+    size_t nThreads = 1;
+    double seconds = 1.0;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            nThreads = max<size_t>(1, stoul(argv[++i]));
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+            seconds = stod(argv[++i]);
+    }
+
+    const RealKernels &k = realKernels();
+    const Problem problems[] = {
+        {"sphere", -5.12, 5.12, k.sumSquares, k.sumSquaresRows},
+        {"rosenbrock", -2.048, 2.048, k.rosenbrock, k.rosenbrockRows},
+        {"schwefel", -500.0, 500.0, k.schwefel, k.schwefelRows},
+    };
+    const size_t popSizes[] = {1u << 6, 1u << 10, 1u << 14};
+
+    const string host = hostName();
+    const string storeDir = "bench_eval_" + host;
+
+    cout << "SIMD=" << simdLevelName(simdLevel()) << ", hilos=" << nThreads << endl;
+    ThreadPool pool(nThreads);
+    mt19937_64 gen(12345);
+
+    for (const Problem &p : problems)
+    {
+        for (size_t popSize : popSizes)
+        {
+            RealPopulation pop(popSize, INDIVIDUAL_SIZE);
+            uniform_real_distribution<double> u(p.lower, p.upper);
+            for (size_t i = 0; i < popSize; ++i)
+                for (size_t j = 0; j < INDIVIDUAL_SIZE; ++j)
+                    pop.row(i)[j] = u(gen);
+            vector<double> single(popSize), batch(popSize);
+
+            // Individuo a individuo: una llamada al núcleo por fila, como eval.evaluate()
+            double perInd = measure(popSize, seconds, [&]
+                                    { pool.parallelFor(popSize, [&](size_t, size_t i)
+                                                       { single[i] = p.single(pop.row(i), INDIVIDUAL_SIZE); }); });
+            // Por lotes: una llamada por bloque contiguo de filas, como eval.evaluateRows()
+            double perBatch = measure(popSize, seconds, [&]
+                                      { pool.parallelRange(popSize, [&](size_t, size_t begin, size_t end)
+                                                           { p.rows(pop.row(begin), pop.rowStride(), INDIVIDUAL_SIZE, end - begin, batch.data() + begin); }); });
+
+            // Ambos caminos deben dar exactamente los mismos valores
+            if (memcmp(single.data(), batch.data(), popSize * sizeof(double)) != 0)
+            {
+                cerr << "ERROR: " << p.name << " por lotes difiere de la evaluación individual" << endl;
+                return 1;
+            }
+
+            cout << setw(10) << p.name << "  pob=" << setw(5) << popSize
+                 << "  individual=" << setw(12) << fixed << setprecision(0) << perInd << " ev/s"
+                 << "  lotes=" << setw(12) << perBatch << " ev/s"
+                 << "  x" << setprecision(2) << perBatch / perInd << endl;
+            StoreRow row;
+            row.text("problem", 16, p.name);
+            row.integer("population_size", int64_t(popSize));
+            row.integer("threads", int64_t(nThreads));
+            row.text("simd", 16, simdLevelName(simdLevel()));
+            row.real("per_individual_evals_s", perInd);
+            row.real("batch_evals_s", perBatch);
+            row.real("speedup", perBatch / perInd);
+            row.text("hostname", 64, host);
+            string error;
+            if (!appendStoreRow(storeDir, row, error))
+                cerr << "Almacén de resultados: " << error << endl;
+        }
+    }
+    return 0;
+}
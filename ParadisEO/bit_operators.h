@@ -0,0 +1,82 @@
+/**
+ * @file bit_operators.h
+ * @brief Operadores de variación sobre cadenas binarias empaquetadas (OneMax).
+ *
+ * Sirven para cualquier individuo con ind.bits (BitSpan), como las vistas de
+ * BitPopulation. apply() recibe el generador de la pareja (counter_rng.h) y
+ * devuelve si ha modificado algún genoma.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "counter_rng.h"
+#include "mutation_sites.h"
+
+// ----------------------------------------------------
+// Cruce de un punto: intercambia las colas a partir de un punto aleatorio
+// ----------------------------------------------------
+struct OnePointCrossover
+{
+    template <class Ind, class Rng>
+    bool apply(Ind &parent1, Ind &parent2, Rng &gen) const
+    {
+        if (parent1.bits.size() != parent2.bits.size())
+            return false;
+        std::size_t n = parent1.bits.size();
+        // Se elige un punto de cruce aleatorio
+        std::size_t point = gen.random(n);
+        parent1.bits.swapTail(parent2.bits, point);
+        return true;
+    }
+};
+
+// ----------------------------------------------------
+// Mutación: flip de bits con una probabilidad dada
+// Con skipSampling se sortean los saltos entre bits mutados (ver mutation_sites.h)
+// en lugar de un número aleatorio por bit; la distribución es la misma.
+// Sin él, las monedas de cada bit se sortean en bloques de COIN_CHUNK de una vez.
+// ----------------------------------------------------
+class BitFlipMutation
+{
+public:
+    BitFlipMutation(double mutationRate, bool skipSampling = false)
+        : mutationRate(mutationRate), skipSampling(skipSampling), sites(mutationRate) {}
+
+    double rate() const { return mutationRate; }
+
+    template <class Ind, class Rng>
+    bool apply(Ind &ind, Rng &gen) const
+    {
+        if (skipSampling)
+        {
+            return sites.forEach(ind.bits.size(), gen, [&ind](std::size_t i)
+                                 { ind.bits.flip(i); });
+        }
+        bool mutated = false;
+        double coin[COIN_CHUNK];
+        const std::size_t n = ind.bits.size();
+        for (std::size_t off = 0; off < n; off += COIN_CHUNK)
+        {
+            std::size_t c = std::min(COIN_CHUNK, n - off);
+            fillUniform(gen, coin, c);
+            for (std::size_t i = 0; i < c; ++i)
+            {
+                if (coin[i] < mutationRate)
+                {
+                    ind.bits.flip(off + i);
+                    mutated = true;
+                }
+            }
+        }
+        return mutated;
+    }
+
+private:
+    static constexpr std::size_t COIN_CHUNK = 256;
+
+    double mutationRate;
+    bool skipSampling;
+    GeometricSiteSampler sites;
+};
@@ -0,0 +1,102 @@
+/**
+ * @file bit_population.h
+ * @brief Población de cadenas binarias empaquetadas en formato estructura de arrays.
+ *
+ * Equivalente binario de RealPopulation: una única matriz N×W de palabras de 64 bits
+ * alineada a 64 bytes (cada fila empieza en línea de caché) más arrays contiguos de
+ * fitness y raw_value. BitIndividualView expone ind.bits (BitSpan), ind.fitness(v) e
+ * ind.raw_value, de modo que los operadores binarios y el motor (ga_engine.h) tratan
+ * igual ambas poblaciones. Como en RealPopulation, BasicBitPopulation<NBits> fija la
+ * longitud en compilación y BitPopulation es la versión dinámica.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "aligned_allocator.h"
+#include "packed_bits.h"
+
+// Vista ligera de un individuo dentro de BitPopulation
+template <std::size_t NBits = DYNAMIC_DIM>
+struct BasicBitIndividualView
+{
+    BasicBitSpan<NBits> bits;
+    double &raw_value;
+    double &fit;
+
+    double fitness() const { return fit; }
+    void fitness(double f) { fit = f; }
+};
+
+typedef BasicBitIndividualView<> BitIndividualView;
+
+template <std::size_t NBits = DYNAMIC_DIM>
+class BasicBitPopulation : private GenomeExtent<NBits>
+{
+public:
+    typedef BitSpan::Word Word;
+    // Palabras por línea de caché: cada fila se rellena hasta un múltiplo de 8
+    static constexpr std::size_t LINE_WORDS = 64 / sizeof(Word);
+
+    BasicBitPopulation(std::size_t n, std::size_t nbits)
+        : GenomeExtent<NBits>(nbits), n(n), words(n * strideFor(nbits), 0), fit(n, 0.0), raw(n, 0.0) {}
+
+    std::size_t size() const { return n; }
+    // Longitud de la cadena en bits
+    std::size_t dim() const { return this->value(); }
+    // Separación en palabras entre filas consecutivas
+    std::size_t rowStride() const { return strideFor(dim()); }
+
+    Word *row(std::size_t i) { return words.data() + i * rowStride(); }
+    const Word *row(std::size_t i) const { return words.data() + i * rowStride(); }
+    double *fitnessData() { return fit.data(); }
+    const double *fitnessData() const { return fit.data(); }
+    double *rawData() { return raw.data(); }
+    const double *rawData() const { return raw.data(); }
+
+    BasicBitIndividualView<NBits> operator[](std::size_t i)
+    {
+        return BasicBitIndividualView<NBits>{BasicBitSpan<NBits>(row(i), dim()), raw[i], fit[i]};
+    }
+
+    // Copia el individuo src[j] (bits, fitness y raw_value) sobre la posición i
+    void copyFrom(std::size_t i, const BasicBitPopulation &src, std::size_t j)
+    {
+        std::memcpy(row(i), src.row(j), BitSpan::wordsFor(dim()) * sizeof(Word));
+        fit[i] = src.fit[j];
+        raw[i] = src.raw[j];
+    }
+
+    // Intercambio O(1) de las reservas de memoria (doble búfer)
+    void swap(BasicBitPopulation &other)
+    {
+        std::swap(static_cast<GenomeExtent<NBits> &>(*this), static_cast<GenomeExtent<NBits> &>(other));
+        std::swap(n, other.n);
+        words.swap(other.words);
+        fit.swap(other.fit);
+        raw.swap(other.raw);
+    }
+
+    // Memoria ocupada por una población de n cadenas de nbits bits
+    static std::size_t bytesFor(std::size_t n, std::size_t nbits)
+    {
+        return n * (strideFor(nbits) * sizeof(Word) + 2 * sizeof(double));
+    }
+
+private:
+    static constexpr std::size_t strideFor(std::size_t nbits)
+    {
+        return (BitSpan::wordsFor(nbits) + LINE_WORDS - 1) / LINE_WORDS * LINE_WORDS;
+    }
+
+    std::size_t n;
+    std::vector<Word, AlignedAllocator<Word, 64>> words;
+    std::vector<double, AlignedAllocator<double, 64>> fit;
+    std::vector<double, AlignedAllocator<double, 64>> raw;
+};
+
+typedef BasicBitPopulation<> BitPopulation;
@@ -0,0 +1,294 @@
+/**
+ * @file campaign.h
+ * @brief Campaña de experimentos completa dentro de un solo proceso (ea_bench -campaign).
+ *
+ * Sustituye a los scripts que lanzaban un binario por ejecución (ejecuciones_SPHERE.py y
+ * los cuadernos): la rejilla de tamaños de población × probabilidades de cruce ×
+ * réplicas se lee de un fichero y cada problema corre sobre un único motor y un único
+ * pool de hilos. Entre ejecuciones el motor solo se reconfigura (reconfigure()), así
+ * que las poblaciones se reservan una vez por tamaño y los hilos ya están creados.
+ * Cada ejecución deja la misma fila, en el mismo fichero, que el binario del problema
+ * (result_rows.h).
+ *
+ * Formato del fichero: líneas "clave = valores", comentarios con '#'. Las claves antes
+ * de la primera sección son los valores comunes; cada sección [onemax], [sphere],
+ * [schwefel] o [rosenbrock] añade ese problema a la campaña, en orden, partiendo de los
+ * valores comunes leídos hasta ese punto. Claves:
+ *   poblaciones = 64 1024 16384     cruces = 0.2 0.01 0.8     replicas = 10
+ *   id_inicial = 1                  hilos = 1                 semilla = 0
+ *   mutacion = 0.1                  mutacion_gen = 0.1        segundos = 120
+ *   generaciones = 0 (0: el límite de generaciones del binario)
+ *   pausa = 0 (segundos de espera entre ejecuciones; los scripts usaban 5)
+ *   ms = 0 (muestreo por saltos)    be = 1 (evaluación por lotes)
+ * Los ID empiezan en id_inicial en cada problema y recorren poblaciones, cruces y
+ * réplicas en ese orden, como los scripts.
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "energy_meter.h"
+#include "perf_counters.h"
+#include "problems.h"
+#include "result_rows.h"
+#include "thread_pool.h"
+#include "trace_writer.h"
+
+// Rejilla de un problema
+struct CampaignGrid
+{
+    std::string problem;
+    std::vector<std::size_t> popSizes = {64, 1024, 16384};
+    std::vector<double> crossoverRates = {0.2, 0.01, 0.8};
+    unsigned replicas = 10;
+    int firstId = 1;
+    std::size_t threads = 1;
+    std::uint32_t seed = 0;
+    double mutationRate = 0.1;
+    double mutationBitRate = 0.1;
+    double maxSeconds = 120.0;
+    // 0: el límite de generaciones del binario del problema
+    std::size_t maxGenerations = 0;
+    double pauseSeconds = 0.0;
+    bool skipSampling = false;
+    bool batchEval = true;
+};
+
+// Lee el fichero de campaña; si hay un error devuelve false y lo describe en error
+inline bool loadCampaign(const std::string &path, std::vector<CampaignGrid> &grids, std::string &error)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        error = "no se puede abrir " + path;
+        return false;
+    }
+    grids.clear();
+    CampaignGrid common;
+    std::string line;
+    for (int lineNo = 1; std::getline(in, line); ++lineNo)
+    {
+        line = line.substr(0, line.find('#'));
+        std::istringstream ls(line);
+        std::string first;
+        if (!(ls >> first))
+            continue;
+        const std::string where = path + ":" + std::to_string(lineNo) + ": ";
+        if (first.front() == '[')
+        {
+            std::string name = first.substr(1, first.find(']') - 1);
+            if (name != "onemax" && name != "sphere" && name != "schwefel" && name != "rosenbrock")
+            {
+                error = where + "problema desconocido '" + name + "'";
+                return false;
+            }
+            grids.push_back(common);
+            grids.back().problem = name;
+            continue;
+        }
+
+        std::size_t eq = line.find('=');
+        if (eq == std::string::npos)
+        {
+            error = where + "se esperaba 'clave = valores'";
+            return false;
+        }
+        std::istringstream keyStream(line.substr(0, eq)), values(line.substr(eq + 1));
+        std::string key;
+        keyStream >> key;
+        CampaignGrid &g = grids.empty() ? common : grids.back();
+        bool ok = true;
+        if (key == "poblaciones")
+        {
+            g.popSizes.clear();
+            std::size_t v;
+            while (values >> v && v > 0)
+                g.popSizes.push_back(v);
+            ok = !g.popSizes.empty() && values.eof();
+        }
+        else if (key == "cruces")
+        {
+            g.crossoverRates.clear();
+            double v;
+            while (values >> v)
+                g.crossoverRates.push_back(v);
+            ok = !g.crossoverRates.empty() && values.eof();
+        }
+        else if (key == "replicas")
+            ok = bool(values >> g.replicas);
+        else if (key == "id_inicial")
+            ok = bool(values >> g.firstId);
+        else if (key == "hilos")
+            ok = bool(values >> g.threads) && g.threads > 0;
+        else if (key == "semilla")
+            ok = bool(values >> g.seed);
+        else if (key == "mutacion")
+            ok = bool(values >> g.mutationRate);
+        else if (key == "mutacion_gen")
+            ok = bool(values >> g.mutationBitRate);
+        else if (key == "segundos")
+            ok = bool(values >> g.maxSeconds);
+        else if (key == "generaciones")
+            ok = bool(values >> g.maxGenerations);
+        else if (key == "pausa")
+            ok = bool(values >> g.pauseSeconds);
+        else if (key == "ms")
+            ok = bool(values >> g.skipSampling);
+        else if (key == "be")
+            ok = bool(values >> g.batchEval);
+        else
+        {
+            error = where + "clave desconocida '" + key + "'";
+            return false;
+        }
+        if (!ok)
+        {
+            error = where + "valor no válido para '" + key + "'";
+            return false;
+        }
+    }
+    if (grids.empty())
+    {
+        error = path + ": la campaña no tiene ningún problema ([onemax], [sphere], [schwefel] o [rosenbrock])";
+        return false;
+    }
+    return true;
+}
+
+// Parámetros fijos de cada binario, para que la fila coincida con la de una ejecución suelta
+inline GaConfig campaignRunConfig(const CampaignGrid &g, std::size_t popSize, double crossoverRate, int id)
+{
+    GaConfig cfg;
+    cfg.popSize = popSize;
+    cfg.crossoverRate = crossoverRate;
+    cfg.seed = g.seed;
+    cfg.runId = std::uint32_t(id);
+    cfg.batchEval = g.batchEval;
+    cfg.maxSeconds = g.maxSeconds;
+    if (g.problem == "onemax")
+        cfg.maxGenerations = 100000;
+    else if (g.problem == "schwefel" || g.problem == "rosenbrock")
+        cfg.maxGenerations = 1000000;
+    if (g.maxGenerations > 0)
+        cfg.maxGenerations = g.maxGenerations;
+    // Schwefel conserva el 5% de élites (al menos uno)
+    if (g.problem == "schwefel")
+        cfg.eliteCount = std::max(std::size_t(1), std::size_t(popSize * 0.05));
+    return cfg;
+}
+
+// Recorre la rejilla de un problema con un único motor. La energía de cada ejecución
+// (energy_meter.h) se reparte entre reconfiguración e inicialización, bucle y salida;
+// los contadores hardware (perf_counters.h) cubren solo el bucle. Con PARADISEO_TRACE
+// todas las ejecuciones van a la misma traza (trace_writer.h)
+template <class GA>
+void runCampaignGrid(GA &ga, const CampaignGrid &g, const EnergyMeter &meter, PerfCounters &perf,
+                     std::ostream &log)
+{
+    TraceWriter trace(g.problem);
+    int id = g.firstId;
+    for (std::size_t popSize : g.popSizes)
+    {
+        for (double pc : g.crossoverRates)
+        {
+            log << "\n=======================================\n"
+                << "CONFIGURACIÓN: Problema=" << g.problem << ", Población=" << popSize << ", Cruce=" << pc
+                << "\n=======================================" << std::endl;
+            for (unsigned rep = 0; rep < g.replicas; ++rep, ++id)
+            {
+                PhaseEnergy energy(meter);
+                energy.begin(PHASE_INIT);
+                const GaConfig cfg = campaignRunConfig(g, popSize, pc, id);
+                ga.reconfigure(cfg);
+                trace.begin(cfg);
+
+                RunRecord rec;
+                rec.problem = g.problem;
+                rec.dim = BENCH_DIM;
+                rec.popSize = popSize;
+                rec.crossoverRate = pc;
+                rec.mutationRate = g.mutationRate;
+                rec.mutationBitRate = g.mutationBitRate;
+                rec.runId = id;
+                rec.threads = g.threads;
+                rec.seed = cfg.seed;
+                rec.eliteCount = cfg.eliteCount;
+                rec.started = std::time(nullptr);
+                rec.result = ga.run([&energy, &perf, &trace](std::size_t gen, const GaResult &r)
+                                    {
+                                        if (gen == 1)
+                                        {
+                                            energy.begin(PHASE_LOOP);
+                                            perf.start();
+                                        }
+                                        trace.record(r);
+                                    });
+                trace.record(rec.result);
+                perf.stop();
+                rec.counters = perf.read();
+
+                energy.begin(PHASE_OUTPUT);
+                log << "Iteración con ID " << id << " completada: generaciones=" << rec.result.generations
+                    << ", fitness=" << rec.result.bestFitness << ", tiempo=" << rec.result.seconds << "s";
+                if (meter.available())
+                    log << ", energía=" << energy.total().total() << " J";
+                log << std::endl;
+                energy.end();
+                for (int ph = 0; ph < PHASE_COUNT; ++ph)
+                    rec.energy[ph] = energy.phase(EnergyPhase(ph));
+                appendResultRow(rec);
+
+                if (g.pauseSeconds > 0.0)
+                    std::this_thread::sleep_for(std::chrono::duration<double>(g.pauseSeconds));
+            }
+        }
+    }
+}
+
+// Ejecuta la campaña completa, problema a problema
+inline void runCampaign(const std::vector<CampaignGrid> &grids, std::ostream &log)
+{
+    EnergyMeter meter;
+    for (const CampaignGrid &g : grids)
+    {
+        if (g.popSizes.empty() || g.crossoverRates.empty())
+            continue;
+        ThreadPool pool(g.threads);
+        PerfCounters perf(pool);
+        GaConfig first = campaignRunConfig(g, g.popSizes.front(), g.crossoverRates.front(), g.firstId);
+        if (g.problem == "onemax")
+        {
+            OneMaxGA ga(first, OneMaxProblem(BENCH_DIM), OnePointCrossover(),
+                        BitFlipMutation(g.mutationRate, g.skipSampling), pool);
+            runCampaignGrid(ga, g, meter, perf, log);
+        }
+        else if (g.problem == "sphere")
+        {
+            SphereGA ga(first, SphereProblem(BENCH_DIM), SBXCrossover(20.0, SphereProblem::LOWER, SphereProblem::UPPER),
+                        PolyMutation(g.mutationRate, 20.0, SphereProblem::LOWER, SphereProblem::UPPER, g.skipSampling), pool);
+            runCampaignGrid(ga, g, meter, perf, log);
+        }
+        else if (g.problem == "schwefel")
+        {
+            SchwefelGA ga(first, SchwefelProblem(BENCH_DIM), SafeSBXCrossover(2.0, SchwefelProblem::LOWER, SchwefelProblem::UPPER),
+                          RealMutation(g.mutationRate, g.mutationBitRate, SchwefelProblem::LOWER, SchwefelProblem::UPPER, g.skipSampling), pool);
+            runCampaignGrid(ga, g, meter, perf, log);
+        }
+        else
+        {
+            RosenbrockGA ga(first, RosenbrockProblem(BENCH_DIM), SafeSBXCrossover(2.0, RosenbrockProblem::LOWER, RosenbrockProblem::UPPER),
+                            RealMutation(g.mutationRate, g.mutationBitRate, RosenbrockProblem::LOWER, RosenbrockProblem::UPPER, g.skipSampling), pool);
+            runCampaignGrid(ga, g, meter, perf, log);
+        }
+    }
+}
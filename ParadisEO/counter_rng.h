@@ -0,0 +1,372 @@
+/**
+ * @file counter_rng.h
+ * @brief Generador aleatorio basado en contador (Philox4x32-10, Salmon et al., SC'11).
+ *
+ * Cada número es una función pura de (clave, contador): la clave sale de
+ * (semilla, identificador de ejecución) y el contador de (generación, individuo,
+ * flujo, bloque). Así cada individuo o pareja de una generación tiene su propia
+ * secuencia, que no depende de qué hilo la genere ni en qué orden, y una ejecución
+ * da exactamente los mismos resultados con cualquier número de hilos.
+ *
+ * CounterRng ofrece la misma interfaz que usan los operadores de eoRng (rand,
+ * uniform, random, normal), de modo que los apply() plantilla lo aceptan sin cambios,
+ * y además rellena bloques de uniformes y normales de una vez (fillUniform,
+ * fillNormal); con AVX2/AVX-512 se calculan 4 u 8 bloques Philox por iteración.
+ * Los bloques vectoriales producen exactamente los mismos bits que los escalares.
+ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "cpu_features.h"
+
+// Mezclador splitmix64 (Steele, Lea y Flood)
+inline std::uint64_t splitmix64(std::uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Clave Philox de una ejecución: mezcla de la semilla y del identificador de ejecución
+inline std::uint64_t counterRngKey(std::uint64_t seed, std::uint64_t runId)
+{
+    return splitmix64(splitmix64(seed) ^ runId);
+}
+
+// Flujos independientes dentro de una misma (generación, individuo)
+enum RngStream : std::uint32_t
+{
+    RNG_STREAM_INIT = 0,  // inicialización de la población
+    RNG_STREAM_BREED = 1, // selección, cruce y mutación de una pareja
+    RNG_STREAM_MIGRATION = 2, // destino de los emigrantes de una isla (islands.h)
+};
+
+// ----------------------------------------------------
+// Philox4x32-10
+// ----------------------------------------------------
+static constexpr std::uint32_t PHILOX_M0 = 0xD2511F53u;
+static constexpr std::uint32_t PHILOX_M1 = 0xCD9E8D57u;
+static constexpr std::uint32_t PHILOX_W0 = 0x9E3779B9u;
+static constexpr std::uint32_t PHILOX_W1 = 0xBB67AE85u;
+static constexpr int PHILOX_ROUNDS = 10;
+
+// Bits de 1.0: con 52 bits aleatorios de mantisa se obtiene un double en [1, 2)
+static constexpr std::uint64_t PHILOX_ONE_BITS = 0x3FF0000000000000ull;
+
+inline void philox4x32(const std::uint32_t ctr[4], std::uint32_t k0, std::uint32_t k1, std::uint32_t out[4])
+{
+    std::uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+    for (int r = 0; r < PHILOX_ROUNDS; ++r)
+    {
+        std::uint64_t p0 = std::uint64_t(PHILOX_M0) * c0;
+        std::uint64_t p1 = std::uint64_t(PHILOX_M1) * c2;
+        c0 = std::uint32_t(p1 >> 32) ^ c1 ^ k0;
+        c1 = std::uint32_t(p1);
+        c2 = std::uint32_t(p0 >> 32) ^ c3 ^ k1;
+        c3 = std::uint32_t(p0);
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+// Dos palabras de 32 bits -> double uniforme en [0, 1) con 52 bits: los 52 bits
+// altos como mantisa de un número en [1, 2), menos 1 (exacto, igual en SIMD)
+inline double philoxUnit(std::uint32_t hi, std::uint32_t lo)
+{
+    std::uint64_t bits = (((std::uint64_t(hi) << 32) | lo) >> 12) | PHILOX_ONE_BITS;
+    double d;
+    std::memcpy(&d, &bits, sizeof d);
+    return d - 1.0;
+}
+
+// ----------------------------------------------------
+// Relleno por bloques: out[2j], out[2j+1] son las dos uniformes del bloque
+// con contador (first + j, c1, c2, c3), para j en [0, nBlocks)
+// ----------------------------------------------------
+typedef void (*PhiloxFillKernel)(std::uint32_t first, std::uint32_t c1, std::uint32_t c2, std::uint32_t c3,
+                                 std::uint32_t k0, std::uint32_t k1, std::size_t nBlocks, double *out);
+
+inline void philoxFillScalar(std::uint32_t first, std::uint32_t c1, std::uint32_t c2, std::uint32_t c3,
+                             std::uint32_t k0, std::uint32_t k1, std::size_t nBlocks, double *out)
+{
+    for (std::size_t j = 0; j < nBlocks; ++j)
+    {
+        std::uint32_t ctr[4] = {first + std::uint32_t(j), c1, c2, c3}, w[4];
+        philox4x32(ctr, k0, k1, w);
+        out[2 * j] = philoxUnit(w[0], w[1]);
+        out[2 * j + 1] = philoxUnit(w[2], w[3]);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Cada palabra ocupa la mitad baja de un carril de 64 bits, que es lo que
+// multiplica _mm256_mul_epu32; los dos productos de 64 bits dan hi y lo.
+// AVX-512 usa las formas maskz por el mismo aviso espurio de GCC 12 que en
+// variation_kernels.h
+__attribute__((target("avx2"))) inline void philoxFillAvx2(std::uint32_t first, std::uint32_t c1, std::uint32_t c2, std::uint32_t c3,
+                                                           std::uint32_t k0, std::uint32_t k1, std::size_t nBlocks, double *out)
+{
+    const __m256i m0 = _mm256_set1_epi64x(PHILOX_M0), m1 = _mm256_set1_epi64x(PHILOX_M1);
+    const __m256i lo32 = _mm256_set1_epi64x(0xFFFFFFFFll);
+    const __m256i oneBits = _mm256_set1_epi64x(PHILOX_ONE_BITS);
+    const __m256d one = _mm256_set1_pd(1.0);
+    std::size_t j = 0;
+    for (; j + 4 <= nBlocks; j += 4)
+    {
+        std::uint32_t base = first + std::uint32_t(j);
+        __m256i x0 = _mm256_setr_epi64x(base, base + 1u, base + 2u, base + 3u);
+        __m256i x1 = _mm256_set1_epi64x(c1), x2 = _mm256_set1_epi64x(c2), x3 = _mm256_set1_epi64x(c3);
+        std::uint32_t r0 = k0, r1 = k1;
+        for (int r = 0; r < PHILOX_ROUNDS; ++r)
+        {
+            __m256i p0 = _mm256_mul_epu32(x0, m0);
+            __m256i p1 = _mm256_mul_epu32(x2, m1);
+            x0 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p1, 32), x1), _mm256_set1_epi64x(r0));
+            x1 = _mm256_and_si256(p1, lo32);
+            x2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p0, 32), x3), _mm256_set1_epi64x(r1));
+            x3 = _mm256_and_si256(p0, lo32);
+            r0 += PHILOX_W0;
+            r1 += PHILOX_W1;
+        }
+        __m256i b01 = _mm256_srli_epi64(_mm256_or_si256(_mm256_slli_epi64(x0, 32), x1), 12);
+        __m256i b23 = _mm256_srli_epi64(_mm256_or_si256(_mm256_slli_epi64(x2, 32), x3), 12);
+        __m256d u01 = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(b01, oneBits)), one);
+        __m256d u23 = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(b23, oneBits)), one);
+        // Orden de salida: bloque a bloque, (u01, u23) de cada uno
+        __m256d lo = _mm256_unpacklo_pd(u01, u23), hi = _mm256_unpackhi_pd(u01, u23);
+        _mm256_storeu_pd(out + 2 * j, _mm256_permute2f128_pd(lo, hi, 0x20));
+        _mm256_storeu_pd(out + 2 * j + 4, _mm256_permute2f128_pd(lo, hi, 0x31));
+    }
+    philoxFillScalar(first + std::uint32_t(j), c1, c2, c3, k0, k1, nBlocks - j, out + 2 * j);
+}
+
+__attribute__((target("avx512f"))) inline void philoxFillAvx512(std::uint32_t first, std::uint32_t c1, std::uint32_t c2, std::uint32_t c3,
+                                                                std::uint32_t k0, std::uint32_t k1, std::size_t nBlocks, double *out)
+{
+    const __m512i m0 = _mm512_set1_epi64(PHILOX_M0), m1 = _mm512_set1_epi64(PHILOX_M1);
+    const __m512i lo32 = _mm512_set1_epi64(0xFFFFFFFFll);
+    const __m512i oneBits = _mm512_set1_epi64(PHILOX_ONE_BITS);
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512i laneOffset = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m512i idxLo = _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11);
+    const __m512i idxHi = _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15);
+    std::size_t j = 0;
+    for (; j + 8 <= nBlocks; j += 8)
+    {
+        // Los contadores de 32 bits dan la vuelta igual que en la versión escalar
+        __m512i x0 = _mm512_and_si512(_mm512_add_epi64(_mm512_set1_epi64(first + std::uint32_t(j)), laneOffset), lo32);
+        __m512i x1 = _mm512_set1_epi64(c1), x2 = _mm512_set1_epi64(c2), x3 = _mm512_set1_epi64(c3);
+        std::uint32_t r0 = k0, r1 = k1;
+        for (int r = 0; r < PHILOX_ROUNDS; ++r)
+        {
+            __m512i p0 = _mm512_maskz_mul_epu32(0xFF, x0, m0);
+            __m512i p1 = _mm512_maskz_mul_epu32(0xFF, x2, m1);
+            x0 = _mm512_xor_si512(_mm512_xor_si512(_mm512_maskz_srli_epi64(0xFF, p1, 32), x1), _mm512_set1_epi64(r0));
+            x1 = _mm512_and_si512(p1, lo32);
+            x2 = _mm512_xor_si512(_mm512_xor_si512(_mm512_maskz_srli_epi64(0xFF, p0, 32), x3), _mm512_set1_epi64(r1));
+            x3 = _mm512_and_si512(p0, lo32);
+            r0 += PHILOX_W0;
+            r1 += PHILOX_W1;
+        }
+        __m512i b01 = _mm512_maskz_srli_epi64(0xFF, _mm512_or_si512(_mm512_maskz_slli_epi64(0xFF, x0, 32), x1), 12);
+        __m512i b23 = _mm512_maskz_srli_epi64(0xFF, _mm512_or_si512(_mm512_maskz_slli_epi64(0xFF, x2, 32), x3), 12);
+        __m512d u01 = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(b01, oneBits)), one);
+        __m512d u23 = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(b23, oneBits)), one);
+        _mm512_storeu_pd(out + 2 * j, _mm512_permutex2var_pd(u01, idxLo, u23));
+        _mm512_storeu_pd(out + 2 * j + 8, _mm512_permutex2var_pd(u01, idxHi, u23));
+    }
+    philoxFillScalar(first + std::uint32_t(j), c1, c2, c3, k0, k1, nBlocks - j, out + 2 * j);
+}
+
+#endif
+
+inline PhiloxFillKernel selectPhiloxFill(SimdLevel l)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    if (l >= SIMD_AVX512)
+        return philoxFillAvx512;
+    if (l >= SIMD_AVX2)
+        return philoxFillAvx2;
+#else
+    (void)l;
+#endif
+    return philoxFillScalar;
+}
+
+// Se elige una sola vez por proceso, como realKernels()
+inline PhiloxFillKernel philoxFill()
+{
+    static const PhiloxFillKernel f = selectPhiloxFill(simdLevel());
+    return f;
+}
+
+// ----------------------------------------------------
+// Generador de un (generación, individuo, flujo): el contador del bloque
+// avanza en la palabra 0 y las otras tres fijan la secuencia
+// ----------------------------------------------------
+class CounterRng
+{
+public:
+    CounterRng(std::uint64_t key, std::uint32_t generation, std::uint32_t individual, std::uint32_t stream)
+        : k0(std::uint32_t(key)), k1(std::uint32_t(key >> 32)), c1(individual), c2(generation), c3(stream) {}
+
+    // Siguiente palabra de 32 bits
+    std::uint32_t rand()
+    {
+        if (pos == 4)
+            refill();
+        return words[pos++];
+    }
+
+    // Uniforme en [0, 1) con 52 bits de resolución; usa siempre las palabras
+    // (0, 1) o (2, 3) de un bloque, igual que fillUniform
+    double uniform()
+    {
+        if (pos & 1)
+            ++pos;
+        std::uint32_t hi = rand();
+        return philoxUnit(hi, rand());
+    }
+
+    double uniform(double a, double b) { return a + (b - a) * uniform(); }
+
+    // Entero en [0, n) por multiplicación (sesgo < n / 2^32)
+    std::uint32_t random(std::uint32_t n) { return std::uint32_t((std::uint64_t(rand()) * n) >> 32); }
+
+    // Normal estándar por Box-Muller; la segunda variable del par se guarda
+    double normal()
+    {
+        if (hasCached)
+        {
+            hasCached = false;
+            return cached;
+        }
+        double u1 = uniform(), u2 = uniform();
+        double z0, z1;
+        boxMuller(u1, u2, z0, z1);
+        cached = z1;
+        hasCached = true;
+        return z0;
+    }
+
+    // Igual que n llamadas a uniform(); los bloques completos se generan con el
+    // núcleo vectorial directamente sobre out
+    void fillUniform(double *out, std::size_t n)
+    {
+        std::size_t i = 0;
+        // Consumir lo que quede del bloque actual (a lo sumo una uniforme)
+        for (; i < n && pos < 3; ++i)
+            out[i] = uniform();
+        std::size_t nBlocks = (n - i) / 2;
+        if (nBlocks > 0)
+        {
+            pos = 4;
+            philoxFill()(block, c1, c2, c3, k0, k1, nBlocks, out + i);
+            block += std::uint32_t(nBlocks);
+            i += 2 * nBlocks;
+        }
+        for (; i < n; ++i)
+            out[i] = uniform();
+    }
+
+    void fillUniform(double *out, std::size_t n, double a, double b)
+    {
+        fillUniform(out, n);
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = a + (b - a) * out[i];
+    }
+
+    // Igual que n llamadas a normal(): uniformes en bloque y Box-Muller por parejas
+    void fillNormal(double *out, std::size_t n)
+    {
+        std::size_t i = 0;
+        if (hasCached && n > 0)
+        {
+            hasCached = false;
+            out[i++] = cached;
+        }
+        std::size_t pairs = (n - i) / 2;
+        fillUniform(out + i, 2 * pairs);
+        for (std::size_t p = 0; p < pairs; ++p, i += 2)
+            boxMuller(out[i], out[i + 1], out[i], out[i + 1]);
+        if (i < n)
+            out[i] = normal();
+    }
+
+private:
+    static void boxMuller(double u1, double u2, double &z0, double &z1)
+    {
+        // 1 - u1 está en (0, 1]: el logaritmo es siempre finito
+        double r = std::sqrt(-2.0 * std::log(1.0 - u1));
+        double theta = 6.283185307179586 * u2;
+        z0 = r * std::cos(theta);
+        z1 = r * std::sin(theta);
+    }
+
+    void refill()
+    {
+        std::uint32_t ctr[4] = {block++, c1, c2, c3};
+        philox4x32(ctr, k0, k1, words);
+        pos = 0;
+    }
+
+    std::uint32_t k0, k1;
+    std::uint32_t c1, c2, c3;
+    std::uint32_t block = 0;
+    std::uint32_t words[4];
+    int pos = 4;
+    double cached = 0.0;
+    bool hasCached = false;
+};
+
+// ----------------------------------------------------
+// Relleno en bloque para los apply() plantilla: con CounterRng usa el camino
+// vectorial y con cualquier otro generador (eoRng) llama valor a valor
+// ----------------------------------------------------
+template <class Rng>
+inline void fillUniform(Rng &gen, double *out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = gen.uniform();
+}
+
+inline void fillUniform(CounterRng &gen, double *out, std::size_t n)
+{
+    gen.fillUniform(out, n);
+}
+
+template <class Rng>
+inline void fillUniform(Rng &gen, double *out, std::size_t n, double a, double b)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = gen.uniform(a, b);
+}
+
+inline void fillUniform(CounterRng &gen, double *out, std::size_t n, double a, double b)
+{
+    gen.fillUniform(out, n, a, b);
+}
+
+template <class Rng>
+inline void fillNormal(Rng &gen, double *out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = gen.normal();
+}
+
+inline void fillNormal(CounterRng &gen, double *out, std::size_t n)
+{
+    gen.fillNormal(out, n);
+}
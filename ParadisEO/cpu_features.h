@@ -0,0 +1,88 @@
+/**
+ * @file cpu_features.h
+ * @brief Detección en tiempo de ejecución de las extensiones de la CPU (CPUID),
+ *        para que un mismo binario elija el núcleo adecuado en el portátil y en el servidor.
+ */
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+
+struct CpuFeatures
+{
+    bool popcnt = false;
+    bool sse2 = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool avx512f = false;
+    bool avx512vpopcntdq = false;
+};
+
+inline CpuFeatures detectCpuFeatures()
+{
+    CpuFeatures f;
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    f.popcnt = __builtin_cpu_supports("popcnt");
+    f.sse2 = __builtin_cpu_supports("sse2");
+    f.avx2 = __builtin_cpu_supports("avx2");
+    f.fma = __builtin_cpu_supports("fma");
+    f.avx512f = __builtin_cpu_supports("avx512f");
+    f.avx512vpopcntdq = f.avx512f && __builtin_cpu_supports("avx512vpopcntdq");
+#endif
+    return f;
+}
+
+// Se detecta una sola vez por proceso
+inline const CpuFeatures &cpuFeatures()
+{
+    static const CpuFeatures f = detectCpuFeatures();
+    return f;
+}
+
+// ----------------------------------------------------
+// Nivel SIMD para los núcleos de coma flotante (simd_kernels.h).
+// AVX2 exige también FMA (i7-7500U y posteriores). La variable de entorno
+// PARADISEO_SIMD=scalar|sse2|avx2|avx512 limita el nivel para poder comparar
+// rutas en la misma máquina; nunca lo sube por encima de lo que soporta la CPU.
+// ----------------------------------------------------
+enum SimdLevel
+{
+    SIMD_SCALAR = 0,
+    SIMD_SSE2 = 1,
+    SIMD_AVX2 = 2,
+    SIMD_AVX512 = 3
+};
+
+inline const char *simdLevelName(SimdLevel l)
+{
+    static const char *names[] = {"scalar", "sse2", "avx2", "avx512"};
+    return names[l];
+}
+
+inline SimdLevel detectSimdLevel()
+{
+    const CpuFeatures &cpu = cpuFeatures();
+    SimdLevel l = SIMD_SCALAR;
+    if (cpu.sse2)
+        l = SIMD_SSE2;
+    if (cpu.avx2 && cpu.fma)
+        l = SIMD_AVX2;
+    if (cpu.avx512f)
+        l = SIMD_AVX512;
+    if (const char *env = std::getenv("PARADISEO_SIMD"))
+    {
+        for (int i = SIMD_SCALAR; i <= SIMD_AVX512; ++i)
+        {
+            if (std::strcmp(env, simdLevelName(SimdLevel(i))) == 0 && i < l)
+                l = SimdLevel(i);
+        }
+    }
+    return l;
+}
+
+inline SimdLevel simdLevel()
+{
+    static const SimdLevel l = detectSimdLevel();
+    return l;
+}
@@ -0,0 +1,580 @@
+/**
+ * @file ea_bench.cpp
+ * @brief Binario único de prueba: cualquiera de los cuatro problemas (OneMax, Sphere,
+ *        Schwefel, Rosenbrock) sobre el mismo motor genético (ga_engine.h, problems.h),
+ *        con una fila por ejecución en el almacén de resultados por columnas.
+ * compilar: c++ ea_bench.cpp -O2 -std=c++17 -pthread -o ea_bench
+ * ejecutar: ./ea_bench -f <onemax|sphere|schwefel|rosenbrock> [-n <dimension>] [-p <poblacion>]
+ *           [-c <cruce>] [-m <mutacion>] [-mb <mutacion por gen>] [-e <fraccion de elites>]
+ *           [-i <id>] [-ms <0|1>] [-t <hilos>] [-s <semilla>] [-be <0|1>] [-le <0|1>]
+ *           [-g <max generaciones>] [-T <segundos>] [-ss <0|1> [-reemplazo <peor|torneo>]]
+ *           [-objetivo <fitness>] [-ckpt <fichero> [-ckpt_cada <generaciones>]] [-resume <fichero>]
+ *           [-islas <K> [-mig <generaciones>] [-migrantes <n>] [-topo <anillo|aleatoria>] [-base <0|1>]
+ *            [-shm <nombre> [-isla <i>]]]
+ *           ./ea_bench -campaign <fichero de campaña>
+ * con -DPARADISEO_PHASE_TIMERS se mide además el tiempo de cada etapa del bucle
+ * (phase_timers.h), que se muestra por consola, y con PARADISEO_PERF=1 se leen los
+ * contadores hardware del bucle (perf_counters.h); con PARADISEO_TRACE=csv|bin se
+ * escribe la traza de convergencia por generación (trace_writer.h) en
+ * traza_<problema>_<host>. Cada ejecución añade su fila, con las etapas y los
+ * contadores en sus columnas (-1 si no se han medido), al almacén por columnas
+ * resultados_<host> (result_store.h, result_rows.h), el mismo de los binarios de cada
+ * problema; se exporta a CSV con resultados.cpp (-csv).
+ *
+ * Con -le 1 (por defecto) los hijos que ni el cruce ni la mutación han modificado
+ * conservan el fitness de su padre y no se evalúan (ga_engine.h); se cuentan aparte
+ * en evaluaciones_omitidas. -le 0 los evalúa todos, como los binarios originales.
+ *
+ * Los valores por defecto reproducen los binarios de cada problema (onemax, sphere_sbx,
+ * schwefel, rosenbrock), salvo la dimensión y el tamaño de población, que son 1024
+ * en todos los casos. Con -n 1024 (BENCH_DIM) se usa la instancia de dimensión fija;
+ * cualquier otra dimensión va por la de dimensión dinámica.
+ *
+ * Con -campaign se ejecuta en este proceso la rejilla completa de un fichero de campaña
+ * (campaign.h, ejemplo en campana_paradiseo.cfg) y cada ejecución deja la fila del
+ * binario de su problema (result_rows.h); el resto de opciones se ignora.
+ *
+ * Con -islas K la población se reparte en K islas, una por hilo (islands.h), que
+ * intercambian cada -mig generaciones (10) sus -migrantes mejores individuos (2) en
+ * anillo o con destino aleatorio; -t se ignora. Con -base 1 se ejecuta antes la
+ * población panmíctica con los mismos K hilos y se comparan calidad, generaciones
+ * por segundo y fitness por kWh.
+ *
+ * Con -shm <nombre> cada isla es un proceso de este mismo binario con sus propios -t
+ * hilos, y los emigrantes pasan por el segmento de memoria compartida /<nombre>
+ * (shm_islands.h; en glibc anteriores a 2.34 hay que enlazar con -lrt). Sin -isla el
+ * proceso hace de lanzador: crea el segmento, arranca las K islas con -isla 0..K-1,
+ * espera a que terminen y muestra el resultado conjunto. Con -isla i el proceso es
+ * solo la isla i, para lanzar las islas a mano (con taskset o numactl por socket,
+ * por ejemplo) con el mismo nombre y las mismas opciones. Cada isla escribe su fila
+ * con su número en la columna isla; -base se ignora.
+ *
+ * Con -ss 1 el bucle es estacionario (ga_engine.h): cada hijo sustituye en su sitio al
+ * peor individuo (-reemplazo peor) o al perdedor de un torneo inverso (-reemplazo
+ * torneo) y solo hay una población; -e y -t no se usan en el bucle. Con -objetivo se
+ * anotan el tiempo, las evaluaciones y la energía del bucle hasta alcanzar ese fitness
+ * (la energía, con la resolución de una generación). Con -base 1 y -ss 1 se ejecuta
+ * antes el bucle generacional con los mismos parámetros y se comparan también tiempo y
+ * energía hasta el objetivo.
+ *
+ * Con -ckpt se escribe un punto de control binario (checkpoint.h) cada -ckpt_cada
+ * generaciones (100) y al terminar; -resume (o --resume) sigue una ejecución desde su
+ * punto de control, con las mismas opciones, y llega al mismo resultado que sin
+ * interrumpirla. Si no se da -ckpt, la ejecución reanudada sigue escribiendo en el
+ * fichero de -resume. No se admite con islas.
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "campaign.h"
+#include "checkpoint.h"
+#include "energy_meter.h"
+#include "islands.h"
+#include "perf_counters.h"
+#include "problems.h"
+#include "result_rows.h"
+#include "shm_islands.h"
+#include "thread_pool.h"
+#include "trace_writer.h"
+
+using namespace std;
+
+// ----------------------------------------------------
+// Una ejecución de GA sobre pool: población panmíctica o, con icfg.islands > 1, modelo
+// de islas (islands.h). Con shm el proceso es solo la isla `island` y migra por memoria
+// compartida (shm_islands.h). La población panmíctica puede reanudarse y guardar
+// puntos de control (checkpoint.h). policies son el problema, el cruce y la mutación
+template <class GA, class Observer, class... Policies>
+GaResult runGa(const string &problem, const GaConfig &cfg, const IslandConfig &icfg, ShmIslandLink *shm,
+               size_t island, const CheckpointConfig &ckpt, ThreadPool &pool, Observer &observer,
+               const Policies &...policies)
+{
+    if (shm)
+    {
+        GA ga(islandRunConfig(cfg, icfg.islands, island, shm->cancelFlag()), policies..., pool);
+        const uint64_t key = counterRngKey(cfg.seed, cfg.runId);
+        vector<size_t> order;
+        GaResult r = ga.run([&](size_t gen, const GaResult &state)
+                            {
+                                observer(gen, state);
+                                if (icfg.islands > 1 && gen > 1 && (gen - 1) % icfg.interval == 0)
+                                    shm->migrate(ga.population(), island, gen, key, order);
+                            });
+        shm->finish(island, r);
+        return r;
+    }
+    if (icfg.islands > 1)
+    {
+        IslandModel<GA> model(cfg, icfg, policies...);
+        return model.run(pool, observer);
+    }
+    GA ga(cfg, policies..., pool);
+    if (ckpt.resume.empty() && ckpt.path.empty())
+        return ga.run(observer);
+
+    string error;
+    size_t saved = 0;
+    if (!ckpt.resume.empty())
+    {
+        CheckpointFile file;
+        auto t = chrono::steady_clock::now();
+        if (!file.open(ckpt.resume, error) || !file.restore(ga.population(), error))
+        {
+            cerr << "Punto de control: " << error << endl;
+            exit(1);
+        }
+        ga.resumeFrom(file.header().result);
+        saved = file.header().result.generations;
+        cout << "Reanudando " << ckpt.resume << " en la generación " << saved << " ("
+             << chrono::duration<double, milli>(chrono::steady_clock::now() - t).count() << " ms)" << endl;
+    }
+
+    // Punto de control cada ckpt.every generaciones (desde el observador, con la
+    // población de la generación recién terminada) y otro al final
+    unsigned writes = 0;
+    double writeMs = 0.0;
+    auto save = [&](const GaResult &state)
+    {
+        auto t = chrono::steady_clock::now();
+        if (!writeCheckpoint(ckpt.path, problem, cfg, ga.population(), state, error))
+            cerr << "Punto de control: " << error << endl;
+        writeMs += chrono::duration<double, milli>(chrono::steady_clock::now() - t).count();
+        ++writes;
+        saved = state.generations;
+    };
+    GaResult r = ga.run([&](size_t gen, const GaResult &state)
+                        {
+                            observer(gen, state);
+                            if (!ckpt.path.empty() && ckpt.every > 0 && state.generations > saved &&
+                                state.generations % ckpt.every == 0)
+                                save(state);
+                        });
+    if (!ckpt.path.empty())
+    {
+        save(r);
+        cout << "Punto de control: " << ckpt.path << ", " << writes << " escrituras, "
+             << writeMs / writes << " ms de media" << endl;
+    }
+    return r;
+}
+
+// ----------------------------------------------------
+// Ejecuta el problema pedido con la longitud de genoma Dim fijada en compilación
+// (DYNAMIC_DIM para las demás longitudes). Devuelve false si el problema no existe.
+// La energía de la construcción y la población inicial va a PHASE_INIT y la del bucle
+// generacional a PHASE_LOOP, igual que los contadores hardware; la del bucle hasta
+// alcanzar el objetivo queda anotada en energy (mark())
+template <std::size_t Dim>
+bool runProblem(const string &problem, size_t dim, const GaConfig &cfg, const IslandConfig &icfg, ShmIslandLink *shm,
+                size_t island, const CheckpointConfig &ckpt, double pm, double pmBit, bool skipSampling, ThreadPool &pool,
+                PhaseEnergy &energy, PerfCounters &perf, GaResult &r)
+{
+    // El bucle empieza en la primera llamada (la generación 1, o la siguiente a la del
+    // punto de control al reanudar)
+    bool looping = false;
+    // Traza de convergencia (trace_writer.h); con islas en hilos, la de la isla 0
+    TraceWriter trace(problem);
+    trace.begin(cfg, shm ? unsigned(island) : 0);
+    auto markLoop = [&energy, &perf, &looping, &trace](size_t, const GaResult &state)
+    {
+        if (!looping)
+        {
+            looping = true;
+            energy.begin(PHASE_LOOP);
+            perf.start();
+        }
+        trace.record(state);
+        if (state.targetSeconds >= 0.0)
+            energy.mark();
+    };
+    energy.begin(PHASE_INIT);
+    if (problem == "onemax")
+    {
+        r = runGa<BasicOneMaxGA<Dim>>(problem, cfg, icfg, shm, island, ckpt, pool, markLoop, OneMaxProblem(dim), OnePointCrossover(),
+                                      BitFlipMutation(pm, skipSampling));
+    }
+    else if (problem == "sphere")
+    {
+        r = runGa<BasicSphereGA<Dim>>(problem, cfg, icfg, shm, island, ckpt, pool, markLoop, SphereProblem(dim),
+                                      SBXCrossover(20.0, SphereProblem::LOWER, SphereProblem::UPPER),
+                                      PolyMutation(pm, 20.0, SphereProblem::LOWER, SphereProblem::UPPER, skipSampling));
+    }
+    else if (problem == "schwefel")
+    {
+        r = runGa<BasicSchwefelGA<Dim>>(problem, cfg, icfg, shm, island, ckpt, pool, markLoop, SchwefelProblem(dim),
+                                        SafeSBXCrossover(2.0, SchwefelProblem::LOWER, SchwefelProblem::UPPER),
+                                        RealMutation(pm, pmBit, SchwefelProblem::LOWER, SchwefelProblem::UPPER, skipSampling));
+    }
+    else if (problem == "rosenbrock")
+    {
+        r = runGa<BasicRosenbrockGA<Dim>>(problem, cfg, icfg, shm, island, ckpt, pool, markLoop, RosenbrockProblem(dim),
+                                          SafeSBXCrossover(2.0, RosenbrockProblem::LOWER, RosenbrockProblem::UPPER),
+                                          RealMutation(pm, pmBit, RosenbrockProblem::LOWER, RosenbrockProblem::UPPER, skipSampling));
+    }
+    else
+        return false;
+    trace.record(r);
+    return true;
+}
+
+// ----------------------------------------------------
+int main(int argc, char **argv)
+{
+    // Parámetros por defecto
+    string problem;
+    size_t dim = 1024;
+    double pm = 0.1, pmBit = 0.1;
+    // < 0: el valor del binario original del problema
+    double crossoverRate = -1.0, eliteFraction = -1.0;
+    int runId = 1;
+    bool skipSampling = false;
+    size_t nThreads = 1;
+    string campaignFile;
+    IslandConfig icfg;
+    bool baseline = false;
+    string shmName;
+    // < 0: lanzador de las islas de -shm
+    long shmIsland = -1;
+    CheckpointConfig ckpt;
+    ckpt.every = 100;
+    GaConfig cfg;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+            problem = argv[++i];
+        else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            dim = stoul(argv[++i]);
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+            cfg.popSize = stoul(argv[++i]);
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+            crossoverRate = stod(argv[++i]);
+        else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+            pm = stod(argv[++i]);
+        else if (strcmp(argv[i], "-mb") == 0 && i + 1 < argc)
+            pmBit = stod(argv[++i]);
+        else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc)
+            eliteFraction = stod(argv[++i]);
+        else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc)
+            runId = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-ms") == 0 && i + 1 < argc)
+            skipSampling = atoi(argv[++i]) != 0;
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            nThreads = max<size_t>(1, stoul(argv[++i]));
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            cfg.seed = (uint32_t)stoul(argv[++i]);
+        else if (strcmp(argv[i], "-be") == 0 && i + 1 < argc)
+            cfg.batchEval = atoi(argv[++i]) != 0;
+        else if (strcmp(argv[i], "-le") == 0 && i + 1 < argc)
+            cfg.lazyEvaluation = atoi(argv[++i]) != 0;
+        else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc)
+            cfg.maxGenerations = stoul(argv[++i]);
+        else if (strcmp(argv[i], "-T") == 0 && i + 1 < argc)
+            cfg.maxSeconds = stod(argv[++i]);
+        else if (strcmp(argv[i], "-islas") == 0 && i + 1 < argc)
+            icfg.islands = max<size_t>(1, stoul(argv[++i]));
+        else if (strcmp(argv[i], "-mig") == 0 && i + 1 < argc)
+            icfg.interval = max<size_t>(1, stoul(argv[++i]));
+        else if (strcmp(argv[i], "-migrantes") == 0 && i + 1 < argc)
+            icfg.migrants = stoul(argv[++i]);
+        else if (strcmp(argv[i], "-topo") == 0 && i + 1 < argc)
+            icfg.topology = (strcmp(argv[++i], "aleatoria") == 0) ? TOPOLOGY_RANDOM : TOPOLOGY_RING;
+        else if (strcmp(argv[i], "-base") == 0 && i + 1 < argc)
+            baseline = atoi(argv[++i]) != 0;
+        else if (strcmp(argv[i], "-ss") == 0 && i + 1 < argc)
+            cfg.steadyState = atoi(argv[++i]) != 0;
+        else if (strcmp(argv[i], "-reemplazo") == 0 && i + 1 < argc)
+            cfg.replacement = (strcmp(argv[++i], "torneo") == 0) ? REPLACE_REVERSE_TOURNAMENT : REPLACE_WORST;
+        else if (strcmp(argv[i], "-objetivo") == 0 && i + 1 < argc)
+            cfg.targetFitness = stod(argv[++i]);
+        else if (strcmp(argv[i], "-ckpt") == 0 && i + 1 < argc)
+            ckpt.path = argv[++i];
+        else if (strcmp(argv[i], "-ckpt_cada") == 0 && i + 1 < argc)
+            ckpt.every = stoul(argv[++i]);
+        else if ((strcmp(argv[i], "-resume") == 0 || strcmp(argv[i], "--resume") == 0) && i + 1 < argc)
+            ckpt.resume = argv[++i];
+        else if (strcmp(argv[i], "-shm") == 0 && i + 1 < argc)
+            shmName = argv[++i];
+        else if (strcmp(argv[i], "-isla") == 0 && i + 1 < argc)
+            shmIsland = atol(argv[++i]);
+        else if (strcmp(argv[i], "-campaign") == 0 && i + 1 < argc)
+            campaignFile = argv[++i];
+    }
+
+    // Modo campaña: toda la rejilla del fichero en este proceso (campaign.h)
+    if (!campaignFile.empty())
+    {
+        vector<CampaignGrid> grids;
+        string error;
+        if (!loadCampaign(campaignFile, grids, error))
+        {
+            cerr << "Campaña: " << error << endl;
+            return 1;
+        }
+        runCampaign(grids, cout);
+        return 0;
+    }
+    cfg.runId = uint32_t(runId);
+
+    // OneMax usaba probabilidad de cruce 0.7 y los demás 0.8
+    if (crossoverRate < 0.0)
+        crossoverRate = (problem == "onemax") ? 0.7 : 0.8;
+    cfg.crossoverRate = crossoverRate;
+    // Solo Schwefel tenía elitismo (5%, al menos un individuo)
+    if (eliteFraction < 0.0)
+        eliteFraction = (problem == "schwefel") ? 0.05 : 0.0;
+    if (eliteFraction > 0.0)
+        cfg.eliteCount = max(size_t(1), size_t(cfg.popSize * eliteFraction));
+
+    // Puntos de control (checkpoint.h): solo población panmíctica; el de -resume debe
+    // ser de esta misma ejecución
+    if (!ckpt.path.empty() || !ckpt.resume.empty())
+    {
+        if (icfg.islands > 1)
+        {
+            cerr << "Los puntos de control no se admiten con islas" << endl;
+            return 1;
+        }
+        if (!ckpt.resume.empty())
+        {
+            CheckpointFile file;
+            string error;
+            if (!file.open(ckpt.resume, error) || !file.matches(problem, dim, cfg, error))
+            {
+                cerr << "Punto de control: " << error << endl;
+                return 1;
+            }
+            if (ckpt.path.empty())
+                ckpt.path = ckpt.resume;
+        }
+    }
+
+    // Islas en procesos (shm_islands.h): el segmento se dimensiona con la fila del genoma
+    ShmIslandLink link;
+    ShmIslandLink *shm = nullptr;
+    if (!shmName.empty())
+    {
+        if (problem != "onemax" && problem != "sphere" && problem != "schwefel" && problem != "rosenbrock")
+        {
+            cerr << "Problema desconocido: '" << problem << "' (onemax, sphere, schwefel o rosenbrock)" << endl;
+            return 1;
+        }
+        if (shmIsland >= long(icfg.islands))
+        {
+            cerr << "-isla " << shmIsland << " fuera de rango (" << icfg.islands << " islas)" << endl;
+            return 1;
+        }
+        size_t slotBytes = (problem == "onemax") ? shmSlotBytes(BasicBitPopulation<>(1, dim))
+                                                 : shmSlotBytes(BasicRealPopulation<>(1, dim));
+        string error;
+        if (!link.open(shmName, icfg, slotBytes, shmIsland < 0, error))
+        {
+            cerr << "Islas en memoria compartida: " << error << endl;
+            return 1;
+        }
+
+        // Lanzador: una copia de este binario por isla con -isla i, y el resultado conjunto
+        if (shmIsland < 0)
+        {
+            vector<pid_t> children;
+            for (size_t i = 0; i < icfg.islands; ++i)
+            {
+                pid_t pid = fork();
+                if (pid == 0)
+                {
+                    vector<string> args(argv, argv + argc);
+                    args.push_back("-isla");
+                    args.push_back(to_string(i));
+                    vector<char *> cargs;
+                    for (string &a : args)
+                        cargs.push_back(&a[0]);
+                    cargs.push_back(nullptr);
+                    execv("/proc/self/exe", cargs.data());
+                    _exit(127);
+                }
+                if (pid < 0)
+                    cerr << "No se pudo lanzar la isla " << i << ": " << strerror(errno) << endl;
+                children.push_back(pid);
+            }
+            int failed = 0;
+            for (size_t i = 0; i < children.size(); ++i)
+            {
+                int status = 0;
+                if (children[i] < 0 || waitpid(children[i], &status, 0) < 0 || !WIFEXITED(status) ||
+                    WEXITSTATUS(status) != 0 || !link.finished(i))
+                {
+                    cerr << "La isla " << i << " no ha terminado correctamente" << endl;
+                    ++failed;
+                }
+            }
+            link.unlink();
+            vector<GaResult> results = link.results();
+            if (!results.empty())
+            {
+                GaResult r = mergeIslandResults(results);
+                cout << problem << " (" << results.size() << " de " << icfg.islands << " islas en procesos, "
+                     << topologyName(icfg.topology) << "): generaciones=" << r.generations
+                     << ", fitness inicial=" << r.initialBestFitness << " → mejor=" << r.bestFitness
+                     << " (gen " << r.bestGeneration << "), raw=" << r.bestRaw
+                     << ", tiempo=" << r.seconds << "s, parada: " << stopReasonName(r.stop) << endl;
+            }
+            return failed ? 1 : 0;
+        }
+        shm = &link;
+    }
+
+    // Con islas en hilos, un hilo por isla
+    if (icfg.islands > 1 && !shm)
+        nThreads = icfg.islands;
+    ThreadPool pool(nThreads);
+    EnergyMeter meter;
+    PerfCounters perf(pool);
+
+    // Una ejecución con su resumen por consola y su fila del almacén; eta es el fitness
+    // por kWh y targetJoules la energía del bucle hasta el objetivo (-1: sin objetivo o
+    // sin medidor). Devuelve false si el problema no existe
+    auto benchRun = [&](const GaConfig &rc, const IslandConfig &ic, const CheckpointConfig &ck, GaResult &r,
+                        double &eta, double &targetJoules) -> bool
+    {
+        time_t started = time(nullptr);
+        PhaseEnergy energy(meter);
+        bool known = (dim == BENCH_DIM)
+                         ? runProblem<BENCH_DIM>(problem, dim, rc, ic, shm, size_t(shmIsland), ck, pm, pmBit,
+                                                 skipSampling, pool, energy, perf, r)
+                         : runProblem<DYNAMIC_DIM>(problem, dim, rc, ic, shm, size_t(shmIsland), ck, pm, pmBit,
+                                                   skipSampling, pool, energy, perf, r);
+        if (!known)
+            return false;
+        // OneMax y Sphere solo tienen una probabilidad de mutación por gen
+        const double pmGene = (problem == "onemax" || problem == "sphere") ? pm : pmBit;
+
+        perf.stop();
+        // Si el objetivo llegó en la última generación, el observador no lo ha visto
+        if (r.targetSeconds >= 0.0)
+            energy.mark();
+        energy.begin(PHASE_OUTPUT);
+        cout << problem;
+        if (shm)
+            cout << " (isla " << shmIsland << " de " << ic.islands << ", proceso " << getpid() << ")";
+        else if (ic.islands > 1)
+            cout << " (" << ic.islands << " islas, " << topologyName(ic.topology) << ")";
+        if (rc.steadyState)
+            cout << " [estacionario, reemplazo " << replacementName(rc.replacement) << "]";
+        cout << ": generaciones=" << r.generations
+             << ", fitness inicial=" << r.initialBestFitness << " → mejor=" << r.bestFitness
+             << " (gen " << r.bestGeneration << "), raw=" << r.bestRaw
+             << ", tiempo=" << r.seconds << "s, parada: " << stopReasonName(r.stop) << endl;
+        if (r.skippedEvaluations > 0)
+            cout << "  Evaluaciones: " << r.evaluations << " (" << r.skippedEvaluations
+                 << " hijos sin modificar no evaluados)" << endl;
+        targetJoules = (r.targetSeconds >= 0.0 && meter.available()) ? energy.markReading().total() : -1.0;
+        if (rc.targetFitness < DBL_MAX)
+        {
+            if (r.targetSeconds >= 0.0)
+            {
+                cout << "  Objetivo " << rc.targetFitness << ": " << r.targetSeconds << " s, "
+                     << r.targetEvaluations << " evaluaciones";
+                if (targetJoules >= 0.0)
+                    cout << ", " << targetJoules << " J";
+                cout << endl;
+            }
+            else
+                cout << "  Objetivo " << rc.targetFitness << ": no alcanzado" << endl;
+        }
+        // Tiempo por etapa (solo con -DPARADISEO_PHASE_TIMERS, phase_timers.h)
+        if (r.stages.enabled)
+            for (int s = 0; s < STAGE_COUNT; ++s)
+                cout << "  " << gaStageName(GaStage(s)) << ": " << r.stages.seconds[s] << " s en "
+                     << r.stages.calls[s] << " llamadas" << endl;
+        // Contadores hardware (solo con PARADISEO_PERF=1, perf_counters.h)
+        const PerfSample counters = perf.read();
+        if (counters.requested && counters.available)
+            cout << "  IPC=" << counters.ipc() << ", fallos LLC/eval="
+                 << counters.perEvaluation(PERF_LLC_MISSES, r.evaluations) << ", fallos de salto/eval="
+                 << counters.perEvaluation(PERF_BRANCH_MISSES, r.evaluations) << endl;
+        else if (counters.requested)
+            cout << "  Contadores hardware: no disponible" << endl;
+        energy.end();
+
+        // Energía (energy_meter.h): la salida cubre el resumen por consola
+        const EnergyReading total = energy.total();
+        eta = fitnessPerKwh(r.bestFitness, total.total());
+        if (meter.available())
+            cout << "Energía: " << total.total() << " J (paquete " << total.package << " J, DRAM " << total.dram
+                 << " J; bucle " << energy.phase(PHASE_LOOP).total() << " J), fitness/kWh="
+                 << eta << endl;
+
+        // Fila del almacén de resultados (result_store.h, resultados_<host>)
+        RunRecord rec;
+        rec.problem = problem;
+        rec.dim = dim;
+        rec.popSize = rc.popSize;
+        rec.crossoverRate = rc.crossoverRate;
+        rec.mutationRate = pm;
+        rec.mutationBitRate = pmGene;
+        rec.runId = runId;
+        rec.threads = nThreads;
+        rec.seed = rc.seed;
+        rec.eliteCount = rc.eliteCount;
+        rec.steadyState = rc.steadyState;
+        rec.replacement = rc.replacement;
+        rec.targetFitness = rc.targetFitness;
+        rec.islands = ic.islands;
+        rec.migrationInterval = ic.interval;
+        rec.migrants = ic.migrants;
+        rec.topology = topologyName(ic.topology);
+        rec.island = shm ? shmIsland : -1;
+        rec.started = started;
+        for (int ph = 0; ph < PHASE_COUNT; ++ph)
+            rec.energy[ph] = energy.phase(EnergyPhase(ph));
+        rec.targetJoules = targetJoules;
+        rec.result = r;
+        rec.counters = counters;
+        appendStoreResult(rec);
+        return true;
+    };
+
+    GaResult r, base;
+    double eta = 0.0, baseEta = 0.0, targetJoules = -1.0, baseTargetJoules = -1.0;
+    // -base 1: antes de las islas o del bucle estacionario, la población panmíctica
+    // generacional completa con los mismos hilos
+    bool compare = baseline && (icfg.islands > 1 || cfg.steadyState) && !shm;
+    GaConfig baseCfg = cfg;
+    baseCfg.steadyState = false;
+    if ((compare && !benchRun(baseCfg, IslandConfig(), CheckpointConfig(), base, baseEta, baseTargetJoules)) ||
+        !benchRun(cfg, icfg, ckpt, r, eta, targetJoules))
+    {
+        cerr << "Problema desconocido: '" << problem << "' (onemax, sphere, schwefel o rosenbrock)" << endl;
+        return 1;
+    }
+    if (compare)
+    {
+        cout << (icfg.islands > 1 ? "Islas" : "Estacionario") << " frente a "
+             << (cfg.steadyState ? "generacional" : "panmíctica") << ": fitness " << r.bestFitness << " / " << base.bestFitness
+             << ", valor " << r.bestRaw << " / " << base.bestRaw
+             << ", gen/s " << (r.seconds > 0.0 ? r.generations / r.seconds : 0.0) << " / "
+             << (base.seconds > 0.0 ? base.generations / base.seconds : 0.0);
+        if (meter.available())
+            cout << ", fitness/kWh " << eta << " / " << baseEta;
+        if (cfg.targetFitness < DBL_MAX)
+        {
+            cout << ", tiempo al objetivo " << r.targetSeconds << " / " << base.targetSeconds << " s";
+            if (meter.available())
+                cout << ", energía al objetivo " << targetJoules << " / " << baseTargetJoules << " J";
+        }
+        cout << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file energy_meter.h
+ * @brief Medida de energía dentro del proceso con los contadores RAPL de la interfaz
+ *        powercap de Linux (/sys/class/powercap/intel-rapl*).
+ *
+ * Se leen los contadores energy_uj de cada paquete (intel-rapl:N con name = package-N)
+ * y de su zona DRAM (intel-rapl:N:M con name = dram), en microjulios. Cada contador
+ * da la vuelta al llegar a max_energy_range_uj; entre dos lecturas se admite como
+ * mucho una vuelta, que con los rangos habituales (cientos de kJ) cubre de sobra una
+ * ejecución.
+ * Las demás subzonas (core, uncore) ya están incluidas en el paquete y no se suman, ni
+ * tampoco la zona psys de los portátiles (intel-rapl:1), que mide la plataforma entera
+ * y contaría los paquetes dos veces.
+ *
+ * La raíz es configurable (constructor o variable de entorno PARADISEO_POWERCAP), de
+ * modo que se puede probar con un árbol de ficheros falso (test_energy_meter.cpp: zonas
+ * DRAM, core/uncore, psys y vuelta de los contadores; termina con código 1 si algo
+ * falla). Si no hay zonas legibles (sin RAPL, o energy_uj solo legible por root)
+ * available() es false y todas las medidas valen 0, que es lo que se escribía antes en
+ * energy_consumed.
+ *
+ * PhaseEnergy reparte la energía de una ejecución entre inicialización, bucle
+ * generacional y salida.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Energía en julios, separada en paquete y DRAM
+struct EnergyReading
+{
+    double package = 0.0;
+    double dram = 0.0;
+
+    double total() const { return package + dram; }
+
+    EnergyReading &operator+=(const EnergyReading &o)
+    {
+        package += o.package;
+        dram += o.dram;
+        return *this;
+    }
+};
+
+// Fitness por kWh (η); 0 si no hay medida de energía
+inline double fitnessPerKwh(double fitness, double joules)
+{
+    return joules > 0.0 ? fitness / (joules / 3.6e6) : 0.0;
+}
+
+// Raíz por defecto: PARADISEO_POWERCAP o /sys/class/powercap
+inline std::string defaultPowercapRoot()
+{
+    const char *env = std::getenv("PARADISEO_POWERCAP");
+    return (env && *env) ? std::string(env) : std::string("/sys/class/powercap");
+}
+
+class EnergyMeter
+{
+public:
+    // Lectura de todos los contadores (microjulios), en el orden de las zonas
+    typedef std::vector<std::uint64_t> Sample;
+
+    explicit EnergyMeter(const std::string &root = defaultPowercapRoot())
+    {
+        DIR *dir = opendir(root.c_str());
+        if (!dir)
+            return;
+        std::vector<std::string> names;
+        while (dirent *e = readdir(dir))
+            names.push_back(e->d_name);
+        closedir(dir);
+
+        // Paquetes: intel-rapl:N (sin más ':') con name = package-N; DRAM: intel-rapl:N:M
+        // con name = dram. Otras zonas de primer nivel (psys, la plataforma entera, que
+        // ya incluye los paquetes) no se suman
+        for (const std::string &n : names)
+        {
+            if (n.compare(0, 11, "intel-rapl:") != 0)
+                continue;
+            bool sub = n.find(':', 11) != std::string::npos;
+            std::string path = root + "/" + n;
+            std::string name = readLine(path + "/name");
+            if (sub ? name != "dram" : name.compare(0, 8, "package-") != 0)
+                continue;
+            addZone(path, sub);
+        }
+        // Algunos núcleos solo exponen las subzonas dentro del directorio del paquete
+        for (std::size_t z = 0, nz = zones.size(); z < nz; ++z)
+        {
+            if (zones[z].dram)
+                continue;
+            DIR *pkg = opendir(zones[z].path.c_str());
+            if (!pkg)
+                continue;
+            std::vector<std::string> subs;
+            while (dirent *e = readdir(pkg))
+                if (std::strncmp(e->d_name, "intel-rapl:", 11) == 0)
+                    subs.push_back(e->d_name);
+            closedir(pkg);
+            for (const std::string &s : subs)
+            {
+                std::string path = zones[z].path + "/" + s;
+                if (readLine(path + "/name") == "dram" && !hasZone(root + "/" + s))
+                    addZone(path, true);
+            }
+        }
+    }
+
+    bool available() const { return !zones.empty(); }
+    std::size_t packageZones() const { return count(false); }
+    std::size_t dramZones() const { return count(true); }
+
+    Sample read() const
+    {
+        Sample s(zones.size(), 0);
+        for (std::size_t z = 0; z < zones.size(); ++z)
+            readCounter(zones[z].path, s[z]);
+        return s;
+    }
+
+    // Energía consumida entre dos lecturas, corrigiendo la vuelta de cada contador
+    EnergyReading between(const Sample &from, const Sample &to) const
+    {
+        EnergyReading r;
+        for (std::size_t z = 0; z < zones.size() && z < from.size() && z < to.size(); ++z)
+        {
+            std::uint64_t d = (to[z] >= from[z]) ? to[z] - from[z] : zones[z].range - from[z] + to[z];
+            (zones[z].dram ? r.dram : r.package) += double(d) * 1e-6;
+        }
+        return r;
+    }
+
+private:
+    struct Zone
+    {
+        std::string path;
+        bool dram;
+        std::uint64_t range;
+    };
+
+    static std::string readLine(const std::string &file)
+    {
+        std::ifstream in(file);
+        std::string line;
+        std::getline(in, line);
+        return line;
+    }
+
+    static bool readCounter(const std::string &path, std::uint64_t &v)
+    {
+        std::ifstream in(path + "/energy_uj");
+        return bool(in >> v);
+    }
+
+    void addZone(const std::string &path, bool dram)
+    {
+        std::uint64_t v, range = 0;
+        if (!readCounter(path, v))
+            return;
+        std::ifstream in(path + "/max_energy_range_uj");
+        if (!(in >> range) || range == 0)
+            range = UINT64_MAX;
+        zones.push_back(Zone{path, dram, range});
+    }
+
+    bool hasZone(const std::string &path) const
+    {
+        for (const Zone &z : zones)
+            if (z.path == path)
+                return true;
+        return false;
+    }
+
+    std::size_t count(bool dram) const
+    {
+        std::size_t n = 0;
+        for (const Zone &z : zones)
+            n += (z.dram == dram);
+        return n;
+    }
+
+    std::vector<Zone> zones;
+};
+
+// ----------------------------------------------------
+// Energía por fases de una ejecución: begin(fase) cierra la fase en curso y abre la
+// siguiente; end() cierra la última
+// ----------------------------------------------------
+enum EnergyPhase
+{
+    PHASE_INIT,
+    PHASE_LOOP,
+    PHASE_OUTPUT,
+    PHASE_COUNT
+};
+
+class PhaseEnergy
+{
+public:
+    explicit PhaseEnergy(const EnergyMeter &meter) : meter(meter) {}
+
+    void begin(EnergyPhase p)
+    {
+        EnergyMeter::Sample now = meter.read();
+        close(now);
+        current = p;
+        open = true;
+        last.swap(now);
+    }
+
+    void end()
+    {
+        if (open)
+            close(meter.read());
+        open = false;
+    }
+
+    const EnergyReading &phase(EnergyPhase p) const { return phases[p]; }
+
+    // Anota la energía de la fase en curso hasta este momento (la primera vez que se
+    // alcanza el fitness objetivo, por ejemplo); las siguientes llamadas no la cambian
+    void mark()
+    {
+        if (markSet || !open)
+            return;
+        markValue = phases[current];
+        markValue += meter.between(last, meter.read());
+        markSet = true;
+    }
+
+    bool hasMark() const { return markSet; }
+    const EnergyReading &markReading() const { return markValue; }
+
+    EnergyReading total() const
+    {
+        EnergyReading t;
+        for (const EnergyReading &p : phases)
+            t += p;
+        return t;
+    }
+
+private:
+    void close(const EnergyMeter::Sample &now)
+    {
+        if (open)
+            phases[current] += meter.between(last, now);
+    }
+
+    const EnergyMeter &meter;
+    EnergyReading phases[PHASE_COUNT];
+    EnergyMeter::Sample last;
+    EnergyPhase current = PHASE_INIT;
+    bool open = false;
+    EnergyReading markValue;
+    bool markSet = false;
+};
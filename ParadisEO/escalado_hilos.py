@@ -0,0 +1,41 @@
+# Escalado del modo multihilo (-t): generaciones/s de 1 a 24 hilos
+# para los cuatro problemas y poblaciones 2^6, 2^10 y 2^14.
+# Compilar antes ea_bench (ver cabecera de ea_bench.cpp) y ejecutar desde esta carpeta.
+import csv
+import socket
+import subprocess
+from itertools import product
+
+from resultados_paradiseo import cargar
+
+host = socket.gethostname()
+
+# Todos los problemas corren sobre el mismo motor y escriben su fila en el almacén de
+# resultados por columnas (resultados_<host>, o PARADISEO_RESULTS)
+problemas = ["onemax", "sphere", "schwefel", "rosenbrock"]
+
+population_sizes = [2**6, 2**10, 2**14]
+hilos = [1, 2, 4, 8, 12, 16, 20, 24]
+semilla = 12345
+crossover_prob = 0.8
+
+
+def ultima_fila():
+    return cargar().iloc[-1]
+
+
+with open(f"escalado_hilos_{host}.csv", "w", newline="") as salida:
+    w = csv.writer(salida)
+    w.writerow(["problema", "poblacion", "hilos", "generaciones", "tiempo", "gen_por_segundo"])
+    for problema, pop_size, t in product(problemas, population_sizes, hilos):
+        print(f"{problema}: Población={pop_size}, Hilos={t}")
+        cmd = ["./ea_bench", "-f", problema, "-p", str(pop_size), "-c", str(crossover_prob),
+               "-t", str(t), "-s", str(semilla)]
+        subprocess.run(cmd, check=True, stdout=subprocess.DEVNULL)
+
+        fila = ultima_fila()
+        gen_s = fila["generaciones"] / fila["tiempo"] if fila["tiempo"] > 0 else 0.0
+        w.writerow([problema, pop_size, t, fila["generaciones"], fila["tiempo"], gen_s])
+        salida.flush()
+
+print("\nESCALADO COMPLETO")
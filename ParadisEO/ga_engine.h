@@ -0,0 +1,522 @@
+/**
+ * @file ga_engine.h
+ * @brief Motor genético generacional único, especializado en compilación por políticas.
+ *
+ * GeneticAlgorithm es una plantilla sobre la población (genoma), el problema, el
+ * cruce, la mutación y la selección. Cada política es una clase normal con métodos
+ * plantilla (sin funciones virtuales), así que init/evaluate/apply/select se
+ * resuelven en compilación y se pueden expandir en línea dentro del bucle.
+ *
+ * Interfaz que se espera de cada política:
+ *   Population: Population(n, dim), size(), operator[](i) (vista con fitness()/raw_value),
+ *               fitnessData(), rawData(), copyFrom(i, src, j), swap(other)
+ *   Problem:    dim(), init(ind, gen), evaluate(ind), evaluateRows(pop, begin, end),
+ *               solved(const GaResult &)
+ *   Crossover:  apply(a, b, gen)        Mutation: apply(ind, gen)
+ *   Selection:  select(fit, n, gen) -> índice del padre
+ *   Timers:     start(workers), now(), lap(w, etapa, t0[, llamadas]), finish()
+ *               (phase_timers.h; NoPhaseTimers no mide nada)
+ *
+ * El bucle es el de los binarios originales: elitismo opcional (topKIndices), parejas
+ * generadas sobre el segundo búfer, cada una con su generador por contador
+ * (counter_rng.h) y repartidas entre los hilos del pool, evaluación por lotes o hijo
+ * a hijo, intercambio de búferes y reducción de estadísticas (generation_stats.h).
+ * El resultado no depende del número de hilos.
+ *
+ * Evaluación perezosa (GaConfig::lazyEvaluation): cruce y mutación devuelven si han
+ * modificado el genoma. Un hijo que ninguno ha tocado es una copia exacta de su padre,
+ * que copyFrom() ha traído ya con su fitness y raw_value, así que no se evalúa y se
+ * cuenta en GaResult::skippedEvaluations. Con evaluación por lotes se evalúan los
+ * tramos contiguos de hijos modificados. Con cruces poco probables (pc = 0,01) y
+ * mutación por individuo (RealMutation con p_ind = 0,1) la mayoría de los hijos se
+ * ahorra la evaluación; el resultado es el mismo que evaluándolos todos.
+ *
+ * Con GaConfig::steadyState el bucle es estacionario: cada pareja se genera, se evalúa
+ * y sus hijos se colocan en la población antes de generar la siguiente. Cada hijo
+ * sustituye, si no es peor que él, al peor individuo (montículo indexado,
+ * WorstIndexHeap) o al perdedor de un torneo inverso, así que el mejor nunca se pierde
+ * y eliteCount no se usa. Solo hay una población (offspring se queda en las dos filas
+ * de la pareja) y el bucle no se reparte entre hilos. Para que generaciones, observador,
+ * islas y límites sigan siendo comparables, una generación estacionaria son las mismas
+ * parejas que una generacional, con los mismos generadores.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "counter_rng.h"
+#include "generation_stats.h"
+#include "phase_timers.h"
+#include "selection.h"
+#include "thread_pool.h"
+
+// Individuo al que sustituye cada hijo en el modo estacionario
+enum SteadyReplacement
+{
+    REPLACE_WORST,
+    REPLACE_REVERSE_TOURNAMENT
+};
+
+// ----------------------------------------------------
+// Parámetros de una ejecución
+// ----------------------------------------------------
+struct GaConfig
+{
+    std::size_t popSize = 1024;
+    double crossoverRate = 0.8;
+    // Clave de los generadores por contador: (semilla, id de ejecución)
+    std::uint32_t seed = 0;
+    std::uint32_t runId = 1;
+    // Evaluación por lotes de cada bloque de hijos (-be 1) o hijo a hijo (-be 0)
+    bool batchEval = true;
+    // Número de mejores individuos que pasan sin cambios a la siguiente generación
+    std::size_t eliteCount = 0;
+    double maxSeconds = 120.0;
+    std::size_t maxGenerations = SIZE_MAX;
+    // Si no es nulo, la ejecución para (STOP_CANCELLED) en cuanto valga true; lo usan
+    // las islas (islands.h) para detenerse todas cuando una resuelve el problema
+    const std::atomic<bool> *cancel = nullptr;
+    // Modo estacionario y su reemplazo (torneo inverso de replacementTournament individuos)
+    bool steadyState = false;
+    SteadyReplacement replacement = REPLACE_WORST;
+    unsigned replacementTournament = 2;
+    // Fitness objetivo: la ejecución anota cuándo lo alcanza por primera vez (no para)
+    double targetFitness = DBL_MAX;
+    // Sin evaluar los hijos que ningún operador ha modificado (-le 0 los evalúa todos)
+    bool lazyEvaluation = true;
+};
+
+enum StopReason
+{
+    STOP_TIMEOUT,
+    STOP_MAX_GENERATIONS,
+    STOP_SOLVED,
+    STOP_CANCELLED
+};
+
+// ----------------------------------------------------
+// Estado acumulado de la ejecución (maximiza fitness y minimiza el valor bruto)
+// ----------------------------------------------------
+struct GaResult
+{
+    // Generaciones completadas
+    std::size_t generations = 0;
+    double initialBestFitness = 0.0;
+    double bestFitness = -DBL_MAX;
+    // Generación en la que se alcanzó bestFitness (0 = población inicial)
+    std::size_t bestGeneration = 0;
+    double bestRaw = DBL_MAX;
+    double worstRaw = -DBL_MAX;
+    // Media y peor fitness de la última generación evaluada
+    double meanFitness = 0.0;
+    double worstFitness = DBL_MAX;
+    // Segundos transcurridos desde el final de la evaluación inicial
+    double seconds = 0.0;
+    // Hijos evaluados en el bucle generacional o estacionario (sin la población inicial)
+    std::uint64_t evaluations = 0;
+    // Hijos sin evaluar por ser copias exactas de su padre (evaluación perezosa)
+    std::uint64_t skippedEvaluations = 0;
+    StopReason stop = STOP_TIMEOUT;
+    // Segundos y evaluaciones hasta alcanzar GaConfig::targetFitness (-1: no se alcanzó)
+    double targetSeconds = -1.0;
+    std::uint64_t targetEvaluations = 0;
+    // Tiempo por etapa del bucle generacional (vacío con NoPhaseTimers)
+    StageProfile stages;
+};
+
+// ----------------------------------------------------
+// Selección por torneo determinista sobre el array de fitness (selection.h)
+// ----------------------------------------------------
+struct TournamentSelection
+{
+    unsigned tSize;
+    explicit TournamentSelection(unsigned tSize = 2) : tSize(tSize) {}
+
+    template <class Rng>
+    std::size_t select(const double *fit, std::size_t n, Rng &gen) const
+    {
+        return detTournamentIndex(fit, n, tSize, gen);
+    }
+};
+
+template <class Population, class Problem, class Crossover, class Mutation,
+          class Selection = TournamentSelection, class Timers = NoPhaseTimers>
+class GeneticAlgorithm
+{
+public:
+    GeneticAlgorithm(const GaConfig &cfg, const Problem &problem, const Crossover &xover,
+                     const Mutation &mutate, ThreadPool &pool, const Selection &select = Selection())
+        : cfg(cfg), problem(problem), xover(xover), mutate(mutate), select(select), pool(pool),
+          rngKey(counterRngKey(cfg.seed, cfg.runId)),
+          pop(cfg.popSize, problem.dim()), offspring(offspringRows(cfg), problem.dim()),
+          spare(pool.size(), problem.dim()), reduceStats(pool), dirty(offspringRows(cfg), 1) {}
+
+    GaResult run()
+    {
+        return run([](std::size_t, const GaResult &) {});
+    }
+
+    // observer(gen, estado) se llama antes de generar cada generación gen (desde 1)
+    template <class Observer>
+    GaResult run(Observer &&observer)
+    {
+        const std::size_t n = cfg.popSize;
+        GaResult r;
+        GenerationStats s;
+
+        if (resuming)
+        {
+            // Población restaurada (checkpoint.h): se sigue desde el estado guardado
+            r = resumed;
+            r.stop = STOP_TIMEOUT;
+            r.stages = StageProfile();
+            resuming = false;
+        }
+        else
+        {
+            // Población inicial: el individuo i usa el generador (0, i, RNG_STREAM_INIT)
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                auto ind = pop[i];
+                CounterRng g(rngKey, 0, std::uint32_t(i), RNG_STREAM_INIT);
+                problem.init(ind, g);
+                if (!cfg.batchEval)
+                    problem.evaluate(ind);
+            }
+            if (cfg.batchEval)
+                problem.evaluateRows(pop, 0, n);
+
+            s = reduceStats(pop.fitnessData(), pop.rawData(), n);
+            r.initialBestFitness = r.bestFitness = s.bestFitness;
+            record(r, s);
+            if (s.bestFitness >= cfg.targetFitness)
+                r.targetSeconds = 0.0;
+        }
+
+        const std::size_t base = cfg.steadyState ? 0 : std::min(cfg.eliteCount, n);
+        const std::size_t nPairs = (n - base + 1) / 2;
+        timers.start(pool.size());
+        // Al reanudar, el reloj sigue desde los segundos ya consumidos
+        auto t0 = std::chrono::steady_clock::now() -
+                  std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(r.seconds));
+        while (true)
+        {
+            r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            if (r.seconds >= cfg.maxSeconds)
+            {
+                r.stop = STOP_TIMEOUT;
+                break;
+            }
+            if (r.generations >= cfg.maxGenerations)
+            {
+                r.stop = STOP_MAX_GENERATIONS;
+                break;
+            }
+            if (cfg.cancel && cfg.cancel->load(std::memory_order_relaxed))
+            {
+                r.stop = STOP_CANCELLED;
+                break;
+            }
+            gen = r.generations + 1;
+            observer(gen, static_cast<const GaResult &>(r));
+
+            std::uint64_t tb;
+            if (cfg.steadyState)
+            {
+                r.evaluations += steadyGeneration(nPairs, r, t0);
+                tb = timers.now();
+            }
+            else
+            {
+                // Los élites se copian a las primeras filas de offspring, de mayor a menor fitness
+                tb = timers.now();
+                if (base > 0)
+                {
+                    topKIndices(pop.fitnessData(), n, base, order);
+                    for (std::size_t i = 0; i < base; ++i)
+                        offspring.copyFrom(i, pop, order[i]);
+                }
+                timers.lap(0, STAGE_BOOKKEEPING, tb, 0);
+
+                // El hilo w genera y evalúa su bloque de parejas
+                if (pool.size() > 1)
+                    pool.parallelRange(nPairs, [&](std::size_t w, std::size_t begin, std::size_t end)
+                                       { breedRange(base, begin, end, w); });
+                else
+                    breedRange(base, 0, nPairs, 0);
+
+                tb = timers.now();
+                pop.swap(offspring);
+                std::uint64_t evaluated = 0;
+                for (std::size_t i = base; i < n; ++i)
+                    evaluated += dirty[i];
+                r.evaluations += evaluated;
+                r.skippedEvaluations += (n - base) - evaluated;
+            }
+            s = reduceStats(pop.fitnessData(), pop.rawData(), n);
+            r.generations = gen;
+            if (s.bestFitness > r.bestFitness)
+            {
+                r.bestFitness = s.bestFitness;
+                r.bestGeneration = gen;
+            }
+            record(r, s);
+            if (r.targetSeconds < 0.0 && s.bestFitness >= cfg.targetFitness)
+            {
+                r.targetSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                r.targetEvaluations = r.evaluations;
+            }
+            bool solved = problem.solved(r);
+            timers.lap(0, STAGE_BOOKKEEPING, tb);
+            if (solved)
+            {
+                r.stop = STOP_SOLVED;
+                break;
+            }
+        }
+        r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        r.stages = timers.finish();
+        return r;
+    }
+
+    // Parámetros de la siguiente ejecución (campañas en un solo proceso, campaign.h).
+    // run() vuelve a inicializar todo el estado, así que el resultado es el mismo que
+    // con un motor nuevo; las poblaciones solo se reservan otra vez si cambia su tamaño
+    void reconfigure(const GaConfig &c)
+    {
+        if (c.popSize != cfg.popSize)
+        {
+            Population a(c.popSize, problem.dim());
+            pop.swap(a);
+        }
+        if (offspringRows(c) != offspring.size())
+        {
+            Population b(offspringRows(c), problem.dim());
+            offspring.swap(b);
+            dirty.assign(offspringRows(c), 1);
+        }
+        cfg = c;
+        rngKey = counterRngKey(cfg.seed, cfg.runId);
+        resuming = false;
+    }
+
+    // La próxima run() no crea la población inicial: sigue desde r (generaciones,
+    // mejor, evaluaciones, tiempo consumido) con la población que ya esté en
+    // population(), restaurada de un punto de control (checkpoint.h). Como los
+    // generadores dependen solo de la clave y la generación, el resultado es el de la
+    // ejecución sin interrumpir
+    void resumeFrom(const GaResult &r)
+    {
+        resumed = r;
+        resuming = true;
+    }
+
+    // Población actual (la última generación evaluada tras run())
+    Population &population() { return pop; }
+    const GaConfig &config() const { return cfg; }
+
+private:
+    // Filas de offspring: la población siguiente o, en modo estacionario, una pareja
+    static std::size_t offspringRows(const GaConfig &c) { return c.steadyState ? 2 : c.popSize; }
+
+    static void record(GaResult &r, const GenerationStats &s)
+    {
+        r.bestRaw = std::min(r.bestRaw, s.bestRaw);
+        r.worstRaw = std::max(r.worstRaw, s.worstRaw);
+        r.meanFitness = s.meanFitness;
+        r.worstFitness = s.worstFitness;
+    }
+
+    // Pareja k -> offspring[base+2k], offspring[base+2k+1]: los padres elegidos se
+    // copian directamente sobre las filas de los hijos y se modifican en su sitio.
+    // Si falta el segundo hueco, el hijo va a la fila sobrante del hilo w y se descarta
+    void breedPair(std::size_t base, std::size_t k, CounterRng &g, std::size_t w)
+    {
+        const std::size_t n = cfg.popSize;
+        std::size_t a = base + 2 * k, b = base + 2 * k + 1;
+        Population &dst2 = (b < n) ? offspring : spare;
+        std::size_t slot2 = (b < n) ? b : w;
+        std::uint64_t t = timers.now();
+        offspring.copyFrom(a, pop, select.select(pop.fitnessData(), n, g));
+        dst2.copyFrom(slot2, pop, select.select(pop.fitnessData(), n, g));
+        auto p1 = offspring[a];
+        auto p2 = dst2[slot2];
+        t = timers.lap(w, STAGE_SELECTION, t);
+
+        const bool crossed = g.uniform() < cfg.crossoverRate && xover.apply(p1, p2, g);
+        t = timers.lap(w, STAGE_CROSSOVER, t);
+
+        // La mutación se aplica siempre (consume su parte del generador)
+        const bool changed1 = mutate.apply(p1, g) || crossed;
+        const bool changed2 = mutate.apply(p2, g) || crossed;
+        t = timers.lap(w, STAGE_MUTATION, t);
+
+        dirty[a] = changed1 || !cfg.lazyEvaluation;
+        if (b < n)
+            dirty[b] = changed2 || !cfg.lazyEvaluation;
+        if (!cfg.batchEval)
+        {
+            if (dirty[a])
+                problem.evaluate(p1);
+            if (b < n && dirty[b])
+                problem.evaluate(p2);
+            timers.lap(w, STAGE_EVALUATION, t);
+        }
+    }
+
+    // Parejas [begin, end): con evaluación por lotes se generan todos los hijos y
+    // después se evalúan de una vez los hijos modificados de offspring[base + 2 begin,
+    // base + 2 end). La pareja k de la generación gen usa el generador
+    // (gen, k, RNG_STREAM_BREED)
+    void breedRange(std::size_t base, std::size_t begin, std::size_t end, std::size_t w)
+    {
+        for (std::size_t k = begin; k < end; ++k)
+        {
+            CounterRng g(rngKey, std::uint32_t(gen), std::uint32_t(k), RNG_STREAM_BREED);
+            breedPair(base, k, g, w);
+        }
+        if (cfg.batchEval)
+        {
+            std::uint64_t t = timers.now();
+            evaluateDirtyRows(base + 2 * begin, std::min(base + 2 * end, cfg.popSize));
+            timers.lap(w, STAGE_EVALUATION, t);
+        }
+    }
+
+    // Evaluación por lotes de cada tramo contiguo de filas modificadas de offspring[begin, end)
+    void evaluateDirtyRows(std::size_t begin, std::size_t end)
+    {
+        std::size_t i = begin;
+        while (i < end)
+        {
+            while (i < end && !dirty[i])
+                ++i;
+            std::size_t j = i;
+            while (j < end && dirty[j])
+                ++j;
+            if (j > i)
+                problem.evaluateRows(offspring, i, j);
+            i = j;
+        }
+    }
+
+    // Una generación estacionaria: nPairs parejas sobre offspring[0, 2), cada una con el
+    // generador de la pareja generacional equivalente, y sus hijos colocados en pop uno a
+    // uno. Para en cuanto el problema queda resuelto; devuelve los hijos evaluados (los
+    // omitidos se suman directamente a r.skippedEvaluations)
+    template <class Clock>
+    std::uint64_t steadyGeneration(std::size_t nPairs, GaResult &r, const Clock &t0)
+    {
+        const std::size_t n = cfg.popSize;
+        double *fit = pop.fitnessData();
+        // El observador puede haber sustituido individuos (islas): montículo nuevo
+        std::uint64_t t = timers.now();
+        if (cfg.replacement == REPLACE_WORST)
+            worstHeap.build(fit, n);
+        timers.lap(0, STAGE_BOOKKEEPING, t, 0);
+
+        std::uint64_t evaluated = 0;
+        for (std::size_t k = 0; k < nPairs; ++k)
+        {
+            CounterRng g(rngKey, std::uint32_t(gen), std::uint32_t(k), RNG_STREAM_BREED);
+            t = timers.now();
+            offspring.copyFrom(0, pop, select.select(fit, n, g));
+            offspring.copyFrom(1, pop, select.select(fit, n, g));
+            auto c1 = offspring[0];
+            auto c2 = offspring[1];
+            t = timers.lap(0, STAGE_SELECTION, t);
+
+            const bool crossed = g.uniform() < cfg.crossoverRate && xover.apply(c1, c2, g);
+            t = timers.lap(0, STAGE_CROSSOVER, t);
+
+            dirty[0] = mutate.apply(c1, g) || crossed || !cfg.lazyEvaluation;
+            dirty[1] = mutate.apply(c2, g) || crossed || !cfg.lazyEvaluation;
+            t = timers.lap(0, STAGE_MUTATION, t);
+
+            if (cfg.batchEval)
+                evaluateDirtyRows(0, 2);
+            else
+            {
+                if (dirty[0])
+                    problem.evaluate(c1);
+                if (dirty[1])
+                    problem.evaluate(c2);
+            }
+            t = timers.lap(0, STAGE_EVALUATION, t);
+
+            for (std::size_t c = 0; c < 2; ++c)
+            {
+                if (dirty[c])
+                    ++evaluated;
+                else
+                    ++r.skippedEvaluations;
+                const double f = offspring.fitnessData()[c];
+                std::size_t victim = (cfg.replacement == REPLACE_WORST) ? worstHeap.worst()
+                                                                        : reverseTournament(fit, n, g);
+                if (f >= fit[victim])
+                {
+                    pop.copyFrom(victim, offspring, c);
+                    if (cfg.replacement == REPLACE_WORST)
+                        worstHeap.update(victim);
+                }
+                r.bestRaw = std::min(r.bestRaw, offspring.rawData()[c]);
+                if (f > r.bestFitness)
+                {
+                    r.bestFitness = f;
+                    r.bestGeneration = gen;
+                }
+                if (r.targetSeconds < 0.0 && f >= cfg.targetFitness)
+                {
+                    r.targetSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+                    r.targetEvaluations = r.evaluations + evaluated;
+                }
+            }
+            bool solved = problem.solved(r);
+            timers.lap(0, STAGE_BOOKKEEPING, t);
+            if (solved)
+                break;
+        }
+        return evaluated;
+    }
+
+    // Perdedor de un torneo inverso: el peor de replacementTournament sorteados
+    template <class Rng>
+    std::size_t reverseTournament(const double *fit, std::size_t n, Rng &g) const
+    {
+        std::size_t loser = g.random(n);
+        for (unsigned t = 1; t < cfg.replacementTournament; ++t)
+        {
+            std::size_t c = g.random(n);
+            if (fit[c] < fit[loser])
+                loser = c;
+        }
+        return loser;
+    }
+
+    GaConfig cfg;
+    Problem problem;
+    Crossover xover;
+    Mutation mutate;
+    Selection select;
+    Timers timers;
+    ThreadPool &pool;
+    std::uint64_t rngKey;
+
+    // Doble búfer y una fila sobrante por hilo
+    Population pop, offspring, spare;
+    GenerationStatsReducer reduceStats;
+    WorstIndexHeap worstHeap;
+    std::vector<std::size_t> order;
+    // Hijos de offspring que algún operador ha modificado (un byte por fila: los hilos
+    // escriben filas contiguas)
+    std::vector<unsigned char> dirty;
+    std::size_t gen = 0;
+    GaResult resumed;
+    bool resuming = false;
+};
@@ -0,0 +1,205 @@
+/**
+ * @file generation_stats.h
+ * @brief Estadísticas de una generación (mejor, peor y media del fitness y del valor
+ *        bruto) por reducción sobre los arrays contiguos de RealPopulation.
+ *
+ * Los evaluadores son funciones puras del genoma y no tocan ningún estado global;
+ * las estadísticas se calculan después de evaluar la generación completa. La
+ * reducción se hace por bloques fijos de GENERATION_STATS_BLOCK elementos, cada uno
+ * con el núcleo SIMD elegido al arrancar y, si hay varios, repartidos entre los hilos
+ * del pool. Los parciales se combinan en orden de bloque, así que el resultado no
+ * depende del número de hilos. Mínimos y máximos son exactos; las medias pueden
+ * diferir en el último bit entre niveles SIMD por el orden de las sumas.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cstddef>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "cpu_features.h"
+#include "thread_pool.h"
+
+// Elementos por bloque de la reducción (32 KiB por array)
+static constexpr std::size_t GENERATION_STATS_BLOCK = 4096;
+
+// Resultado para una población que maximiza fitness y minimiza el valor bruto
+struct GenerationStats
+{
+    double bestFitness = -DBL_MAX;
+    double worstFitness = DBL_MAX;
+    double meanFitness = 0.0;
+    double bestRaw = DBL_MAX;
+    double worstRaw = -DBL_MAX;
+    double meanRaw = 0.0;
+};
+
+// Parcial de un bloque
+struct StatsPartial
+{
+    double minFit, maxFit, sumFit;
+    double minRaw, maxRaw, sumRaw;
+};
+
+typedef void (*StatsKernel)(const double *fit, const double *raw, std::size_t n, StatsPartial &out);
+
+inline void statsScalar(const double *fit, const double *raw, std::size_t n, StatsPartial &out)
+{
+    StatsPartial p = {DBL_MAX, -DBL_MAX, 0.0, DBL_MAX, -DBL_MAX, 0.0};
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        p.minFit = std::min(p.minFit, fit[i]);
+        p.maxFit = std::max(p.maxFit, fit[i]);
+        p.sumFit += fit[i];
+        p.minRaw = std::min(p.minRaw, raw[i]);
+        p.maxRaw = std::max(p.maxRaw, raw[i]);
+        p.sumRaw += raw[i];
+    }
+    out = p;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Los carriles se combinan con la cola escalar en un orden fijo
+__attribute__((target("avx2"))) inline void statsAvx2(const double *fit, const double *raw, std::size_t n, StatsPartial &out)
+{
+    __m256d minF = _mm256_set1_pd(DBL_MAX), maxF = _mm256_set1_pd(-DBL_MAX), sumF = _mm256_setzero_pd();
+    __m256d minR = minF, maxR = maxF, sumR = sumF;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d f = _mm256_loadu_pd(fit + i), r = _mm256_loadu_pd(raw + i);
+        minF = _mm256_min_pd(minF, f);
+        maxF = _mm256_max_pd(maxF, f);
+        sumF = _mm256_add_pd(sumF, f);
+        minR = _mm256_min_pd(minR, r);
+        maxR = _mm256_max_pd(maxR, r);
+        sumR = _mm256_add_pd(sumR, r);
+    }
+    alignas(32) double l[6][4];
+    _mm256_store_pd(l[0], minF);
+    _mm256_store_pd(l[1], maxF);
+    _mm256_store_pd(l[2], sumF);
+    _mm256_store_pd(l[3], minR);
+    _mm256_store_pd(l[4], maxR);
+    _mm256_store_pd(l[5], sumR);
+    statsScalar(fit + i, raw + i, n - i, out);
+    for (int k = 0; k < 4; ++k)
+    {
+        out.minFit = std::min(out.minFit, l[0][k]);
+        out.maxFit = std::max(out.maxFit, l[1][k]);
+        out.sumFit += l[2][k];
+        out.minRaw = std::min(out.minRaw, l[3][k]);
+        out.maxRaw = std::max(out.maxRaw, l[4][k]);
+        out.sumRaw += l[5][k];
+    }
+}
+
+// min/max en forma maskz por el aviso espurio de GCC 12 (ver variation_kernels.h)
+__attribute__((target("avx512f"))) inline void statsAvx512(const double *fit, const double *raw, std::size_t n, StatsPartial &out)
+{
+    __m512d minF = _mm512_set1_pd(DBL_MAX), maxF = _mm512_set1_pd(-DBL_MAX), sumF = _mm512_setzero_pd();
+    __m512d minR = minF, maxR = maxF, sumR = sumF;
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m512d f = _mm512_loadu_pd(fit + i), r = _mm512_loadu_pd(raw + i);
+        minF = _mm512_maskz_min_pd(0xFF, minF, f);
+        maxF = _mm512_maskz_max_pd(0xFF, maxF, f);
+        sumF = _mm512_add_pd(sumF, f);
+        minR = _mm512_maskz_min_pd(0xFF, minR, r);
+        maxR = _mm512_maskz_max_pd(0xFF, maxR, r);
+        sumR = _mm512_add_pd(sumR, r);
+    }
+    alignas(64) double l[6][8];
+    _mm512_store_pd(l[0], minF);
+    _mm512_store_pd(l[1], maxF);
+    _mm512_store_pd(l[2], sumF);
+    _mm512_store_pd(l[3], minR);
+    _mm512_store_pd(l[4], maxR);
+    _mm512_store_pd(l[5], sumR);
+    statsScalar(fit + i, raw + i, n - i, out);
+    for (int k = 0; k < 8; ++k)
+    {
+        out.minFit = std::min(out.minFit, l[0][k]);
+        out.maxFit = std::max(out.maxFit, l[1][k]);
+        out.sumFit += l[2][k];
+        out.minRaw = std::min(out.minRaw, l[3][k]);
+        out.maxRaw = std::max(out.maxRaw, l[4][k]);
+        out.sumRaw += l[5][k];
+    }
+}
+#endif
+
+inline StatsKernel selectStatsKernel(SimdLevel level)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    if (level >= SIMD_AVX512)
+        return statsAvx512;
+    if (level >= SIMD_AVX2)
+        return statsAvx2;
+#else
+    (void)level;
+#endif
+    return statsScalar;
+}
+
+inline StatsKernel statsKernel()
+{
+    static const StatsKernel k = selectStatsKernel(simdLevel());
+    return k;
+}
+
+// ----------------------------------------------------
+// Reducción por generación; guarda los parciales entre llamadas para no
+// reservar memoria en cada generación
+// ----------------------------------------------------
+class GenerationStatsReducer
+{
+public:
+    explicit GenerationStatsReducer(ThreadPool &pool) : pool(pool) {}
+
+    GenerationStats operator()(const double *fit, const double *raw, std::size_t n)
+    {
+        GenerationStats s;
+        if (n == 0)
+            return s;
+        const std::size_t nBlocks = (n + GENERATION_STATS_BLOCK - 1) / GENERATION_STATS_BLOCK;
+        partials.resize(nBlocks);
+        auto block = [&](std::size_t b)
+        {
+            std::size_t begin = b * GENERATION_STATS_BLOCK;
+            std::size_t len = std::min(GENERATION_STATS_BLOCK, n - begin);
+            statsKernel()(fit + begin, raw + begin, len, partials[b]);
+        };
+        if (nBlocks > 1 && pool.size() > 1)
+            pool.parallelFor(nBlocks, [&](std::size_t, std::size_t b)
+                             { block(b); });
+        else
+        {
+            for (std::size_t b = 0; b < nBlocks; ++b)
+                block(b);
+        }
+
+        double sumFit = 0.0, sumRaw = 0.0;
+        for (const StatsPartial &p : partials)
+        {
+            s.bestFitness = std::max(s.bestFitness, p.maxFit);
+            s.worstFitness = std::min(s.worstFitness, p.minFit);
+            sumFit += p.sumFit;
+            s.bestRaw = std::min(s.bestRaw, p.minRaw);
+            s.worstRaw = std::max(s.worstRaw, p.maxRaw);
+            sumRaw += p.sumRaw;
+        }
+        s.meanFitness = sumFit / double(n);
+        s.meanRaw = sumRaw / double(n);
+        return s;
+    }
+
+private:
+    ThreadPool &pool;
+    std::vector<StatsPartial> partials;
+};
@@ -0,0 +1,38 @@
+/**
+ * @file genome_extent.h
+ * @brief Longitud del genoma fijada en compilación o, como alternativa, al construir.
+ *
+ * Las poblaciones y las vistas de individuo (real_population.h, bit_population.h,
+ * packed_bits.h) heredan de GenomeExtent<Dim>. Con Dim fijo, value() es constexpr y
+ * el compilador ve bucles de longitud constante (copias de filas, bloques de los
+ * operadores, recorridos de palabras) que puede desenrollar y vectorizar; la vista
+ * se reduce a un puntero. Con DYNAMIC_DIM la longitud se guarda en el objeto, como
+ * un std::span de extensión dinámica.
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+
+// Longitud desconocida en compilación
+static constexpr std::size_t DYNAMIC_DIM = 0;
+
+template <std::size_t Dim>
+class GenomeExtent
+{
+public:
+    // La longitud pedida en ejecución debe coincidir con la de compilación
+    explicit GenomeExtent(std::size_t d) { assert(d == Dim); (void)d; }
+    static constexpr std::size_t value() { return Dim; }
+};
+
+template <>
+class GenomeExtent<DYNAMIC_DIM>
+{
+public:
+    explicit GenomeExtent(std::size_t d) : d(d) {}
+    std::size_t value() const { return d; }
+
+private:
+    std::size_t d;
+};
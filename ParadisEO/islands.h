@@ -0,0 +1,291 @@
+/**
+ * @file islands.h
+ * @brief Modelo de islas: K subpoblaciones, una por hilo, cada una con su propio
+ *        motor generacional (ga_engine.h), que intercambian sus mejores individuos
+ *        cada M generaciones por colas acotadas sin bloqueos.
+ *
+ * Cada isla corre el bucle normal de GeneticAlgorithm sobre popSize / K individuos en
+ * un trabajador del pool, sin ninguna sincronización entre generaciones. Al empezar
+ * cada generación múltiplo de M (desde el observador de run()) la isla copia sus
+ * `migrants` mejores individuos a la cola de su vecina y sustituye sus peores
+ * individuos por los que haya en sus colas de entrada. Si una cola está llena los
+ * emigrantes se descartan: nunca se espera a otra isla.
+ *
+ * MigrantQueue es una cola circular de un productor y un consumidor (SPSC) cuyas
+ * casillas son filas de una población del mismo tipo que la de las islas, de modo que
+ * un emigrante se copia con copyFrom() igual que un élite y no se reserva memoria
+ * durante la ejecución. Topologías:
+ *   TOPOLOGY_RING:   la isla i envía siempre a la i + 1 (K colas)
+ *   TOPOLOGY_RANDOM: en cada migración la isla i elige un destino distinto de sí misma
+ *                    con su generador (gen, i, RNG_STREAM_MIGRATION) (K (K - 1) colas)
+ *
+ * Cada isla tiene su propia clave de generador (semilla mezclada con el número de
+ * isla), pero el momento en que llegan los emigrantes depende del reparto de los
+ * hilos, así que con K > 1 el resultado no es reproducible bit a bit. Cuando una isla
+ * resuelve el problema las demás paran (STOP_CANCELLED) al empezar su siguiente
+ * generación.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "counter_rng.h"
+#include "ga_engine.h"
+#include "selection.h"
+#include "thread_pool.h"
+
+enum MigrationTopology
+{
+    TOPOLOGY_RING,
+    TOPOLOGY_RANDOM
+};
+
+struct IslandConfig
+{
+    // Número de islas (1 = población panmíctica, sin islas)
+    std::size_t islands = 1;
+    // Generaciones entre migraciones
+    std::size_t interval = 10;
+    // Individuos que emigra cada isla en cada migración
+    std::size_t migrants = 2;
+    MigrationTopology topology = TOPOLOGY_RING;
+    // Casillas de cada cola (0: cuatro migraciones)
+    std::size_t capacity = 0;
+};
+
+inline const char *topologyName(MigrationTopology t)
+{
+    return t == TOPOLOGY_RANDOM ? "aleatoria" : "anillo";
+}
+
+// Configuración de la isla i de k: su parte del tamaño de población y de los élites y
+// una semilla mezclada con el número de isla
+inline GaConfig islandRunConfig(const GaConfig &cfg, std::size_t k, std::size_t i,
+                                const std::atomic<bool> *cancel)
+{
+    GaConfig c = cfg;
+    c.popSize = cfg.popSize / k + (i < cfg.popSize % k);
+    if (cfg.eliteCount > 0)
+        c.eliteCount = std::max<std::size_t>(1, cfg.eliteCount * c.popSize / cfg.popSize);
+    c.seed = std::uint32_t(splitmix64((std::uint64_t(cfg.seed) << 32) | (i + 1)));
+    c.cancel = cancel;
+    return c;
+}
+
+// Una migración de la isla i: sus mejores individuos a la cola de su destino y los que
+// esperan en sus colas de entrada sobre sus peores. queueOf(origen, destino) devuelve la
+// cola de ese par (nullptr si la topología no la tiene); vale cualquier cola con
+// push(población, j) y pop(población, i), en memoria del proceso o compartida
+template <class Population, class QueueOf>
+void migrateIsland(Population &pop, std::size_t i, std::size_t gen, const IslandConfig &icfg,
+                   std::uint64_t key, std::vector<std::size_t> &order, QueueOf &&queueOf)
+{
+    const std::size_t k = icfg.islands;
+    const std::size_t n = pop.size();
+
+    // Emigrantes: los mejores de la isla hacia su destino
+    std::size_t dest = (i + 1) % k;
+    if (icfg.topology == TOPOLOGY_RANDOM)
+    {
+        CounterRng g(key, std::uint32_t(gen), std::uint32_t(i), RNG_STREAM_MIGRATION);
+        dest = (i + 1 + g.random(k - 1)) % k;
+    }
+    const std::size_t m = std::min(icfg.migrants, n);
+    topKIndices(pop.fitnessData(), n, m, order);
+    auto *out = queueOf(i, dest);
+    for (std::size_t e = 0; e < m; ++e)
+        if (!out->push(pop, order[e]))
+            break;
+
+    // Inmigrantes: sustituyen a los peores, como mucho `migrants` por cola
+    std::size_t sources = (icfg.topology == TOPOLOGY_RANDOM) ? k - 1 : 1;
+    bottomKIndices(pop.fitnessData(), n, std::min(n, m * sources), order);
+    std::size_t next = 0;
+    for (std::size_t s = 0; s < k; ++s)
+    {
+        auto *in = (s == i) ? nullptr : queueOf(s, i);
+        if (!in)
+            continue;
+        for (std::size_t e = 0; e < m && next < order.size() && next < m * sources; ++e)
+        {
+            if (!in->pop(pop, order[next]))
+                break;
+            ++next;
+        }
+    }
+}
+
+// Resultado conjunto: el mejor de todas las islas, generaciones y tiempo de la isla
+// más lenta, evaluaciones (hechas y omitidas) y etapas sumadas, y el objetivo de la
+// isla más rápida
+inline GaResult mergeIslandResults(const std::vector<GaResult> &results)
+{
+    GaResult m = results[0];
+    double meanSum = results[0].meanFitness;
+    for (std::size_t i = 1; i < results.size(); ++i)
+    {
+        const GaResult &r = results[i];
+        m.initialBestFitness = std::max(m.initialBestFitness, r.initialBestFitness);
+        if (r.bestFitness > m.bestFitness)
+        {
+            m.bestFitness = r.bestFitness;
+            m.bestGeneration = r.bestGeneration;
+        }
+        m.bestRaw = std::min(m.bestRaw, r.bestRaw);
+        m.worstRaw = std::max(m.worstRaw, r.worstRaw);
+        m.worstFitness = std::min(m.worstFitness, r.worstFitness);
+        m.generations = std::max(m.generations, r.generations);
+        m.seconds = std::max(m.seconds, r.seconds);
+        m.evaluations += r.evaluations;
+        m.skippedEvaluations += r.skippedEvaluations;
+        meanSum += r.meanFitness;
+        if (r.stop == STOP_SOLVED)
+            m.stop = STOP_SOLVED;
+        // Objetivo: la primera isla que lo alcanza, con sus evaluaciones
+        if (r.targetSeconds >= 0.0 && (m.targetSeconds < 0.0 || r.targetSeconds < m.targetSeconds))
+        {
+            m.targetSeconds = r.targetSeconds;
+            m.targetEvaluations = r.targetEvaluations;
+        }
+        for (int s = 0; s < STAGE_COUNT; ++s)
+        {
+            m.stages.seconds[s] += r.stages.seconds[s];
+            m.stages.calls[s] += r.stages.calls[s];
+        }
+    }
+    m.meanFitness = meanSum / double(results.size());
+    return m;
+}
+
+// ----------------------------------------------------
+// Cola SPSC acotada de individuos
+// ----------------------------------------------------
+template <class Population>
+class MigrantQueue
+{
+public:
+    MigrantQueue(std::size_t capacity, std::size_t dim) : buf(capacity, dim), cap(capacity) {}
+
+    // Productor: copia src[j] a la cola; false (y se descarta) si está llena
+    bool push(const Population &src, std::size_t j)
+    {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == cap)
+            return false;
+        buf.copyFrom(t % cap, src, j);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor: saca el emigrante más antiguo sobre dst[i]; false si está vacía
+    bool pop(Population &dst, std::size_t i)
+    {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+            return false;
+        dst.copyFrom(i, buf, h % cap);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    Population buf;
+    std::size_t cap;
+    // Cada índice en su línea de caché: solo lo escribe uno de los dos extremos
+    alignas(64) std::atomic<std::size_t> head{0};
+    alignas(64) std::atomic<std::size_t> tail{0};
+};
+
+// ----------------------------------------------------
+// Modelo de islas sobre cualquier instancia GA de GeneticAlgorithm
+// ----------------------------------------------------
+template <class GA>
+class IslandModel
+{
+public:
+    typedef typename std::remove_reference<decltype(std::declval<GA &>().population())>::type Population;
+
+    // policies son los argumentos de GA entre la configuración y el pool (problema,
+    // cruce, mutación); cada isla recibe una copia
+    template <class... Policies>
+    IslandModel(const GaConfig &cfg, const IslandConfig &icfg, const Policies &...policies)
+        : cfg(cfg), icfg(icfg)
+    {
+        const std::size_t k = std::max<std::size_t>(1, icfg.islands);
+        this->icfg.islands = k;
+        if (this->icfg.capacity == 0)
+            this->icfg.capacity = 4 * std::max<std::size_t>(1, icfg.migrants);
+
+        for (std::size_t i = 0; i < k; ++i)
+        {
+            pools.emplace_back(new ThreadPool(1));
+            islands.emplace_back(new GA(islandRunConfig(cfg, k, i, &cancelled), policies..., *pools.back()));
+        }
+
+        // Colas (origen, destino) de la topología
+        queues.resize(k * k);
+        const std::size_t dim = islands[0]->population().dim();
+        for (std::size_t i = 0; i < k && k > 1; ++i)
+            for (std::size_t j = 0; j < k; ++j)
+                if (j != i && (icfg.topology == TOPOLOGY_RANDOM || j == (i + 1) % k))
+                    queues[i * k + j].reset(new MigrantQueue<Population>(this->icfg.capacity, dim));
+    }
+
+    std::size_t size() const { return islands.size(); }
+    const IslandConfig &config() const { return icfg; }
+
+    GaResult run(ThreadPool &pool)
+    {
+        return run(pool, [](std::size_t, const GaResult &) {});
+    }
+
+    // Cada isla corre en un trabajador de pool (las que sobren se reparten en bloques);
+    // observer(gen, estado) se llama solo desde la isla 0
+    template <class Observer>
+    GaResult run(ThreadPool &pool, Observer &&observer)
+    {
+        const std::size_t k = islands.size();
+        cancelled.store(false);
+        std::vector<GaResult> results(k);
+        std::vector<std::vector<std::size_t>> orders(k);
+        pool.parallelRange(k, [&](std::size_t, std::size_t begin, std::size_t end)
+                           {
+                               for (std::size_t i = begin; i < end; ++i)
+                               {
+                                   results[i] = islands[i]->run([&, i](std::size_t gen, const GaResult &r)
+                                                                {
+                                                                    if (i == 0)
+                                                                        observer(gen, r);
+                                                                    if (k > 1 && gen > 1 && (gen - 1) % icfg.interval == 0)
+                                                                        migrate(i, gen, orders[i]);
+                                                                });
+                                   if (results[i].stop == STOP_SOLVED)
+                                       cancelled.store(true);
+                               } });
+        return mergeIslandResults(results);
+    }
+
+private:
+    void migrate(std::size_t i, std::size_t gen, std::vector<std::size_t> &order)
+    {
+        const std::size_t k = islands.size();
+        migrateIsland(islands[i]->population(), i, gen, icfg, migrationKey, order,
+                      [this, k](std::size_t src, std::size_t dst)
+                      { return queues[src * k + dst].get(); });
+    }
+
+    GaConfig cfg;
+    IslandConfig icfg;
+    std::uint64_t migrationKey = counterRngKey(cfg.seed, cfg.runId);
+    std::atomic<bool> cancelled{false};
+    std::vector<std::unique_ptr<ThreadPool>> pools;
+    std::vector<std::unique_ptr<GA>> islands;
+    std::vector<std::unique_ptr<MigrantQueue<Population>>> queues;
+};
@@ -1,151 +1,42 @@
 /**
  * @file onemax.cpp
  * @author fjluque
- * @brief compilar con > c++ onemax.cpp -I../eo/src -I../edo/src -std=c++17 -L./lib/ -leo -leoutils -o onemax
- * @brief ejecutar con ./onemax -p <tamanio_poblacion> -c <probabilidad_cruce> -i <id>
+ * @brief compilar con > c++ onemax.cpp -O2 -std=c++17 -pthread -o onemax
+ * @brief ejecutar con ./onemax -p <tamanio_poblacion> -c <probabilidad_cruce> -i <id> [-ms <0|1>] [-t <hilos>] [-s <semilla>]
  * @version 0.1
  * @date 2025-04-03
  *
  * @copyright Copyright (c) 2025
  *
  */
-#include <eo>
 #include <iostream>
-#include <vector>
 #include <algorithm>
+#include <cmath>
 #include <ctime>
-#include <chrono>
-#include <unistd.h> // Para gethostname
 #include <string>
 #include <cstdlib>
-#include <fstream> // Para guardar el CSV
 
-using namespace std;
-
-//-----------------------------------------------------
-// Definición del individuo para OneMax (cadena binaria)
-// Hereda de EO con fitness de maximización.
-class OneMax : public EO<eoMaximizingFitness>
-{
-public:
-    vector<bool> bits{0};
-
-    OneMax() {}
-    OneMax(size_t n) : bits(n, false) {}
-
-    // Imprime la cadena
-    void printOn(ostream &os) const override
-    {
-        for (bool b : bits)
-        {
-            os << b;
-        }
-    }
-
-    // Lectura del individuo (usando índices para vector<bool>)
-    void readFrom(istream &is) override
-    {
-        for (size_t i = 0; i < bits.size(); ++i)
-        {
-            char c;
-            is >> c;
-            bits[i] = (c == '1');
-        }
-    }
-};
-
-//-----------------------------------------------------
-// Función de evaluación: cuenta el número de 1
-class OneMaxEval : public eoEvalFunc<OneMax>
-{
-public:
-    void operator()(OneMax &ind) override
-    {
-        int count = 0;
-        for (bool b : ind.bits)
-        {
-            if (b)
-                count++;
-        }
-        // Se asigna el fitness (objetivo: maximizar el número de 1)
-        ind.fitness(count);
-    }
-};
-
-//-----------------------------------------------------
-// Operador de inicialización: genera una cadena aleatoria
-class OneMaxInit : public eoInit<OneMax>
-{
-public:
-    OneMaxInit(size_t n) : n(n) {}
-
-    void operator()(OneMax &ind) override
-    {
-        ind.bits.resize(n);
-        for (size_t i = 0; i < n; ++i)
-        {
-            // Cada bit se inicializa a true con probabilidad 0.5
-            ind.bits[i] = (eo::rng.uniform() < 0.5);
-        }
-    }
-
-private:
-    size_t n;
-};
-
-//-----------------------------------------------------
-// Operador de cruce de un punto para cadenas binarias
-class OnePointCrossover : public eoQuadOp<OneMax>
-{
-public:
-    bool operator()(OneMax &parent1, OneMax &parent2) override
-    {
-        if (parent1.bits.size() != parent2.bits.size())
-            return false;
-        size_t n = parent1.bits.size();
-        // Se elige un punto de cruce aleatorio
-        size_t point = eo::rng.random(n);
-        for (size_t i = point; i < n; ++i)
-        {
-            swap(parent1.bits[i], parent2.bits[i]);
-        }
-        return true;
-    }
-};
-
-//-----------------------------------------------------
-// Operador de mutación: flip de bits con una probabilidad dada
-class BitFlipMutation : public eoMonOp<OneMax>
-{
-public:
-    BitFlipMutation(double mutationRate) : mutationRate(mutationRate) {}
+#include "energy_meter.h"
+#include "perf_counters.h"
+#include "problems.h"
+#include "result_rows.h"
+#include "thread_pool.h"
+#include "trace_writer.h"
 
-    bool operator()(OneMax &ind) override
-    {
-        bool mutated = false;
-        for (size_t i = 0; i < ind.bits.size(); ++i)
-        {
-            if (eo::rng.uniform() < mutationRate)
-            {
-                ind.bits[i] = !ind.bits[i];
-                mutated = true;
-            }
-        }
-        return mutated;
-    }
-
-private:
-    double mutationRate;
-};
+using namespace std;
 
 //-----------------------------------------------------
 // Función auxiliar para parsear argumentos desde argv
-void parseArgs(int argc, char **argv, size_t &popSize, double &pc, int &id)
+void parseArgs(int argc, char **argv, size_t &popSize, double &pc, int &id, bool &skipSampling,
+               size_t &nThreads, uint32_t &seed)
 {
     // Valores por defecto
     popSize = 50;
     pc = 0.7;
     id = 1;
+    skipSampling = false;
+    nThreads = 1;
+    seed = 0;
     for (int i = 1; i < argc; i++)
     {
         string arg = argv[i];
@@ -161,6 +52,18 @@ void parseArgs(int argc, char **argv, size_t &popSize, double &pc, int &id)
         {
             id = stod(argv[++i]);
         }
+        else if (arg == "-ms" && i + 1 < argc)
+        {
+            skipSampling = stoi(argv[++i]) != 0;
+        }
+        else if (arg == "-t" && i + 1 < argc)
+        {
+            nThreads = max<size_t>(1, stoul(argv[++i]));
+        }
+        else if (arg == "-s" && i + 1 < argc)
+        {
+            seed = (uint32_t)stoul(argv[++i]);
+        }
     }
 }
 
@@ -171,7 +74,10 @@ int main(int argc, char **argv)
     size_t popSize;
     double pc;
     int id;
-    parseArgs(argc, argv, popSize, pc, id);
+    bool skipSampling;
+    size_t nThreads;
+    uint32_t seed;
+    parseArgs(argc, argv, popSize, pc, id, skipSampling, nThreads, seed);
 
     const size_t nbits = 1024;             // Longitud de la cadena binaria (fitness máximo = nbits)
     const double pm = 0.1;                 // Probabilidad de mutación (fija)
@@ -180,170 +86,67 @@ int main(int argc, char **argv)
     // Condiciones de parada: fitness == nbits (100%) o timeout de 2 minutos (120 segundos)
     const int timeout_seconds = 120;
 
-    // Datos para la salida final
-    string stop_reason = "";
-    size_t generation_stop = 0;
-    int fitness_initial = 0;
-    int best_fitness = 0;
-    size_t generation_max_fitness = 0;
-
-    // Obtener fecha y hora de inicio
+    // Fecha y hora de inicio
     time_t now_time = time(nullptr);
-    char time_str[100];
-    strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", localtime(&now_time));
-    string fecha_hora = time_str;
-    string framework = "Paradiseo";
-
-    // Obtener el hostname (dónde se ha ejecutado)
-    char hostname[1024];
-    gethostname(hostname, sizeof(hostname));
-    string ejecutado_en = hostname;
-
-    // Inicializar la semilla del generador de números aleatorios
-    eo::rng.reseed(now_time);
-
-    // Inicialización de la población
-    OneMaxInit initializer(nbits);
-    eoPop<OneMax> pop;
-    for (size_t i = 0; i < popSize; i++)
-    {
-        OneMax ind(nbits);
-        initializer(ind);
-        pop.push_back(ind);
-    }
-
-    // Evaluar la población inicial
-    OneMaxEval eval;
-    for (auto &ind : pop)
-    {
-        eval(ind);
-    }
-
-    // Registrar el fitness inicial
-    auto bestIt = max_element(pop.begin(), pop.end(), [](const OneMax &a, const OneMax &b)
-                                   { return a.fitness() < b.fitness(); });
-    fitness_initial = bestIt->fitness();
-    best_fitness = fitness_initial;
-    generation_max_fitness = 0;
-
-    // Iniciar el cronómetro
-    auto start = chrono::steady_clock::now();
 
-    // Operadores genéticos
-    OnePointCrossover crossover;
-    BitFlipMutation mutation(pm);
-    eoDetTournamentSelect<OneMax> select(2);
-
-    // Bucle principal del algoritmo genético
-    size_t gen;
-    bool sig = true;
-    for (gen = 1; gen <= nGenerationsMax && sig; gen++)
+    // Motor genético único (ga_engine.h) con las políticas de OneMax (problems.h):
+    // generadores por contador con clave (semilla, id de ejecución), así que el
+    // resultado no depende del número de hilos
+    ThreadPool pool(nThreads);
+    // Contadores hardware del bucle (perf_counters.h), solo con PARADISEO_PERF=1
+    PerfCounters perf(pool);
+    GaConfig cfg;
+    cfg.popSize = popSize;
+    cfg.crossoverRate = pc;
+    cfg.seed = seed;
+    cfg.runId = uint32_t(id);
+    cfg.maxSeconds = timeout_seconds;
+    cfg.maxGenerations = nGenerationsMax;
+
+    // Energía RAPL por fases (energy_meter.h): inicialización, bucle y salida
+    EnergyMeter meter;
+    PhaseEnergy energy(meter);
+    energy.begin(PHASE_INIT);
+
+    OneMaxGA ga(cfg, OneMaxProblem(nbits), OnePointCrossover(), BitFlipMutation(pm, skipSampling), pool);
+    // Traza de convergencia por generación (trace_writer.h), solo con PARADISEO_TRACE
+    TraceWriter trace("onemax");
+    trace.begin(cfg);
+    GaResult result = ga.run([&energy, &perf, &trace](size_t gen, const GaResult &r)
     {
-        eoPop<OneMax> newPop;
-        while (newPop.size() < popSize)
-        {
-            // Seleccionar dos padres
-            OneMax parent1 = select(pop);
-            OneMax parent2 = select(pop);
-
-            // Aplicar cruce con probabilidad pc
-            if (eo::rng.uniform() < pc)
-            {
-                crossover(parent1, parent2);
-            }
-            // Aplicar mutación
-            mutation(parent1);
-            mutation(parent2);
-
-            // Evaluar los descendientes
-            eval(parent1);
-            eval(parent2);
-
-            // Agregar a la nueva población
-            newPop.push_back(parent1);
-            if (newPop.size() < popSize)
-                newPop.push_back(parent2);
-        }
-        pop = newPop;
-
-        // Evaluar el mejor fitness de la generación actual
-        bestIt = max_element(pop.begin(), pop.end(), [](const OneMax &a, const OneMax &b)
-                                  { return a.fitness() < b.fitness(); });
-        int current_best = bestIt->fitness();
-        if (current_best > best_fitness)
+        if (gen == 1)
         {
-            best_fitness = current_best;
-            generation_max_fitness = gen;
+            energy.begin(PHASE_LOOP);
+            perf.start();
         }
-        
-        auto now = chrono::steady_clock::now();
-        auto elapsed = chrono::duration_cast<chrono::seconds>(now - start).count();
-        generation_stop = gen; // Se actualiza cada generación
-        
-        // Comprobar condiciones de parada
-        if (current_best >= (int)nbits)
-        {
-            stop_reason = "Fitness alcanzado";
-            sig = false;
-        }
-        if (elapsed >= timeout_seconds)
-        {
-            stop_reason = "Timeout de 2 minutos";
-            sig = false;
-        }
-    }
-
-    // Calcular el tiempo total de ejecución
-    auto finish = chrono::steady_clock::now();
-    double tiempo_ejecucion = chrono::duration_cast<chrono::milliseconds>(finish - start).count() / 1000.0;
-
-    // Calcular la variación de fitness (fitness_maximo - fitness_inicial)
-    int variacion_fitness = best_fitness - fitness_initial;
-
-    // Imprimir la información final
-    /*
-    cout << "================ Resumen de la ejecución ================\n";
-    cout << "ID: " << id << "\n";
-    cout << "Fecha y hora: " << fecha_hora << "\n";
-    cout << "Framework: " << framework << "\n";
-    cout << "Tamaño de la población: " << popSize << "\n";
-    cout << "Probabilidad de cruce: " << pc << "\n";
-    cout << "Probabilidad de mutación: " << pm << "\n";
-    cout << "Generación alcanzada: " << generation_stop << "\n";
-    cout << "Fitness inicial: " << fitness_initial << "\n";
-    cout << "Variación de fitness: " << variacion_fitness << "\n";
-    cout << "Fitness final: " << best_fitness << "\n";
-    cout << "Tiempo de ejecución (s): " << tiempo_ejecucion << "\n";
-    cout << "Generación donde se alcanzó el fitness máximo: " << generation_max_fitness << "\n";
-    cout << "Fitness máximo alcanzado: " << best_fitness << "\n";
-    cout << "Motivo de parada: " << (stop_reason.empty() ? "Fin de generaciones" : stop_reason) << "\n";
-    cout << "Dónde se ha ejecutado: " << ejecutado_en << "\n";
-    cout << "==========================================================\n";
-    */
-    // Guardar los resultados en CSV
-    ofstream csv("onemax_resultados.csv", ios::app);
-    // Si el archivo está vacío, escribir la cabecera
-    if (csv.tellp() == 0)
-    {
-        csv << "ID,Fecha_Hora,Framework,Tamano_individuo,Tamano_Poblacion,Prob_Cruce,Prob_Mutacion,Gen_Alcanzada,Fitness_Inicial,Variacion_Fitness,Fitness_Final,Tiempo_Ejecucion,Gen_Fitness_Max,Fitness_Max,Motivo_Parada,Donde_Ejecutado\n";
-    }
-    csv << id << ","
-        << fecha_hora << ","
-        << framework << ","
-        << nbits << ","
-        << popSize << ","
-        << pc << ","
-        << pm << ","
-        << generation_stop << ","
-        << fitness_initial << ","
-        << variacion_fitness << ","
-        << best_fitness << ","
-        << tiempo_ejecucion << ","
-        << generation_max_fitness << ","
-        << best_fitness << ","
-        << (stop_reason.empty() ? "Fin de generaciones" : stop_reason) << ","
-        << ejecutado_en << "\n";
-    csv.close();
+        trace.record(r);
+    });
+    trace.record(result);
+    perf.stop();
+    energy.begin(PHASE_OUTPUT);
+    energy.end();
+    if (meter.available())
+        cout << "Energía: " << energy.total().total() << " J (bucle "
+             << energy.phase(PHASE_LOOP).total() << " J) | fitness/kWh="
+             << fitnessPerKwh(result.bestFitness, energy.total().total()) << endl;
+
+    // Guardar los resultados en CSV (onemax_resultados.csv, result_rows.h)
+    RunRecord rec;
+    rec.problem = "onemax";
+    rec.dim = nbits;
+    rec.popSize = popSize;
+    rec.crossoverRate = pc;
+    rec.mutationRate = pm;
+    rec.runId = id;
+    rec.threads = nThreads;
+    rec.seed = cfg.seed;
+    rec.eliteCount = cfg.eliteCount;
+    rec.started = now_time;
+    rec.result = result;
+    rec.counters = perf.read();
+    for (int ph = 0; ph < PHASE_COUNT; ++ph)
+        rec.energy[ph] = energy.phase(EnergyPhase(ph));
+    appendResultRow(rec);
 
     return 0;
 }
@@ -0,0 +1,158 @@
+/**
+ * @file packed_bits.h
+ * @brief Cadena binaria empaquetada en palabras de 64 bits.
+ *
+ * Sustituye a vector<bool>: la evaluación pasa a ser una reducción por popcount
+ * (VPOPCNTDQ de AVX-512 si la CPU lo tiene, popcnt escalar si no) y el cruce de un
+ * punto se reduce a intercambiar palabras completas más una única palabra frontera
+ * enmascarada. Los bits de relleno de la última palabra se mantienen siempre a 0.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "cpu_features.h"
+#include "genome_extent.h"
+
+// ----------------------------------------------------
+// Núcleos de popcount sobre un bloque de palabras
+// ----------------------------------------------------
+typedef std::size_t (*PopcountFn)(const std::uint64_t *, std::size_t);
+
+inline std::size_t popcountWordsGeneric(const std::uint64_t *w, std::size_t n)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        count += __builtin_popcountll(w[i]);
+    return count;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("popcnt"))) inline std::size_t popcountWordsPopcnt(const std::uint64_t *w, std::size_t n)
+{
+    // Cuatro acumuladores independientes para no encadenar la latencia de popcnt
+    std::size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        c0 += __builtin_popcountll(w[i]);
+        c1 += __builtin_popcountll(w[i + 1]);
+        c2 += __builtin_popcountll(w[i + 2]);
+        c3 += __builtin_popcountll(w[i + 3]);
+    }
+    for (; i < n; ++i)
+        c0 += __builtin_popcountll(w[i]);
+    return c0 + c1 + c2 + c3;
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) inline std::size_t popcountWordsAvx512(const std::uint64_t *w, std::size_t n)
+{
+    __m512i acc = _mm512_setzero_si512();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_loadu_si512(w + i)));
+    if (i < n)
+    {
+        // Cola enmascarada: menos de 8 palabras
+        __mmask8 tail = __mmask8((1u << (n - i)) - 1u);
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(tail, w + i)));
+    }
+    alignas(64) std::uint64_t lanes[8];
+    _mm512_store_si512(lanes, acc);
+    return std::size_t(lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7]);
+}
+#endif
+
+inline PopcountFn selectPopcount()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    const CpuFeatures &cpu = cpuFeatures();
+    if (cpu.avx512vpopcntdq)
+        return popcountWordsAvx512;
+    if (cpu.popcnt)
+        return popcountWordsPopcnt;
+#endif
+    return popcountWordsGeneric;
+}
+
+inline std::size_t popcountWords(const std::uint64_t *w, std::size_t n)
+{
+    static const PopcountFn fn = selectPopcount();
+    return fn(w, n);
+}
+
+// ----------------------------------------------------
+// Vista de una cadena de bits empaquetada (palabras ajenas, p. ej. una fila de
+// BitPopulation). Como GeneSpan, la vista es ligera y se pasa por valor: los
+// métodos const modifican los bits, no la vista. Con NBits fijo (genome_extent.h)
+// la longitud y el número de palabras son constantes y la vista es solo un puntero.
+// ----------------------------------------------------
+template <std::size_t NBits = DYNAMIC_DIM>
+class BasicBitSpan : private GenomeExtent<NBits>
+{
+public:
+    typedef std::uint64_t Word;
+    static constexpr std::size_t WORD_BITS = 64;
+
+    BasicBitSpan(Word *w, std::size_t nbits) : GenomeExtent<NBits>(nbits), w(w) {}
+
+    static constexpr std::size_t wordsFor(std::size_t n) { return (n + WORD_BITS - 1) / WORD_BITS; }
+
+    std::size_t size() const { return this->value(); }
+    std::size_t nwords() const { return wordsFor(size()); }
+    Word *data() const { return w; }
+
+    bool get(std::size_t i) const { return (w[i / WORD_BITS] >> (i % WORD_BITS)) & 1u; }
+    void set(std::size_t i, bool v) const
+    {
+        Word m = Word(1) << (i % WORD_BITS);
+        if (v)
+            w[i / WORD_BITS] |= m;
+        else
+            w[i / WORD_BITS] &= ~m;
+    }
+    void flip(std::size_t i) const { w[i / WORD_BITS] ^= Word(1) << (i % WORD_BITS); }
+
+    // Número de bits a 1
+    std::size_t count() const { return popcountWords(w, nwords()); }
+
+    // Máscara de bits válidos de la última palabra (todo a 1 si n es múltiplo de 64)
+    Word lastWordMask() const
+    {
+        std::size_t r = size() % WORD_BITS;
+        return r ? (Word(1) << r) - 1 : ~Word(0);
+    }
+
+    // Pone a 0 los bits de relleno tras escribir palabras completas
+    void clearPadding() const
+    {
+        if (size() > 0)
+            w[nwords() - 1] &= lastWordMask();
+    }
+
+    // Intercambia los bits [point, size) con otra cadena del mismo tamaño:
+    // una palabra frontera enmascarada y el resto palabra a palabra.
+    void swapTail(const BasicBitSpan &other, std::size_t point) const
+    {
+        std::size_t i = point / WORD_BITS;
+        const std::size_t n = nwords();
+        if (i >= n)
+            return;
+        Word mask = ~Word(0) << (point % WORD_BITS);
+        Word diff = (w[i] ^ other.w[i]) & mask;
+        w[i] ^= diff;
+        other.w[i] ^= diff;
+        for (++i; i < n; ++i)
+            std::swap(w[i], other.w[i]);
+    }
+
+private:
+    Word *w;
+};
+
+typedef BasicBitSpan<> BitSpan;
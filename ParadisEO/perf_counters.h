@@ -0,0 +1,229 @@
+/**
+ * @file perf_counters.h
+ * @brief Contadores hardware por ejecución (perf_event_open) alrededor del bucle
+ *        generacional: ciclos, instrucciones, fallos de LLC y fallos de predicción
+ *        de saltos, y en CPU híbridas los ciclos de cada tipo de núcleo.
+ *
+ * Es opcional: solo se abre si la variable de entorno PARADISEO_PERF vale 1. Cada
+ * trabajador del pool abre su propio grupo desde su hilo (pid = 0), de modo que se
+ * cuentan exactamente los hilos que generan descendientes, y los grupos se activan y
+ * desactivan todos a la vez desde el hilo que llama. Solo se cuenta espacio de
+ * usuario, que es lo que permite perf_event_paranoid = 2.
+ *
+ * En las CPU híbridas de Intel (PMU cpu_core y cpu_atom en
+ * /sys/bus/event_source/devices) se abre un grupo por PMU con el tipo extendido en los
+ * bits altos de config; cada grupo solo cuenta mientras el hilo corre en ese tipo de
+ * núcleo, así que la proporción de ciclos en núcleos eficientes sale de comparar los
+ * dos. Los valores se escalan por time_enabled / time_running si el núcleo ha tenido
+ * que multiplexar.
+ *
+ * Si el núcleo no ofrece los contadores (contenedores, máquinas virtuales sin PMU,
+ * perf_event_paranoid demasiado alto) available() es false y las medidas se
+ * escriben como "no disponible".
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "thread_pool.h"
+
+enum PerfEvent
+{
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_EVENT_COUNT
+};
+
+// Medida de una ejecución; -1 en los contadores que no se han podido abrir
+struct PerfSample
+{
+    // Se pidieron los contadores (PARADISEO_PERF=1) y se pudo abrir al menos el de ciclos
+    bool requested = false;
+    bool available = false;
+    bool hybrid = false;
+    double counts[PERF_EVENT_COUNT] = {-1.0, -1.0, -1.0, -1.0};
+    // Ciclos en núcleos eficientes (solo en CPU híbridas)
+    double atomCycles = -1.0;
+
+    double ipc() const
+    {
+        return (counts[PERF_CYCLES] > 0.0 && counts[PERF_INSTRUCTIONS] >= 0.0)
+                   ? counts[PERF_INSTRUCTIONS] / counts[PERF_CYCLES]
+                   : -1.0;
+    }
+
+    // Contador e por evaluación; -1 si no hay contador o evaluaciones
+    double perEvaluation(PerfEvent e, std::uint64_t evaluations) const
+    {
+        return (counts[e] >= 0.0 && evaluations > 0) ? counts[e] / double(evaluations) : -1.0;
+    }
+};
+
+inline bool perfCountersRequested()
+{
+    const char *env = std::getenv("PARADISEO_PERF");
+    return env && std::strcmp(env, "1") == 0;
+}
+
+class PerfCounters
+{
+public:
+    // Abre los grupos en cada trabajador de pool si se han pedido (PARADISEO_PERF=1)
+    explicit PerfCounters(ThreadPool &pool, bool requested = perfCountersRequested())
+        : requested(requested)
+    {
+        if (!requested)
+            return;
+        pmuTypes = hybridPmuTypes();
+        if (pmuTypes.empty())
+            pmuTypes.push_back(0);
+        groups.assign(pool.size() * pmuTypes.size(), Group());
+        pool.run([this](std::size_t w)
+                 {
+                     for (std::size_t k = 0; k < pmuTypes.size(); ++k)
+                         openGroup(groups[w * pmuTypes.size() + k], pmuTypes[k]);
+                 });
+    }
+
+    ~PerfCounters()
+    {
+        for (Group &g : groups)
+            for (int fd : g.fd)
+                if (fd >= 0)
+                    close(fd);
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    bool available() const
+    {
+        for (const Group &g : groups)
+            if (g.fd[PERF_CYCLES] >= 0)
+                return true;
+        return false;
+    }
+
+    // Pone a cero y activa todos los grupos
+    void start()
+    {
+        for (Group &g : groups)
+            if (g.fd[PERF_CYCLES] >= 0)
+            {
+                ioctl(g.fd[PERF_CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                ioctl(g.fd[PERF_CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+    }
+
+    void stop()
+    {
+        for (Group &g : groups)
+            if (g.fd[PERF_CYCLES] >= 0)
+                ioctl(g.fd[PERF_CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    // Suma de todos los trabajadores desde el último start()
+    PerfSample read() const
+    {
+        PerfSample s;
+        s.requested = requested;
+        s.available = available();
+        s.hybrid = pmuTypes.size() > 1;
+        if (!s.available)
+            return s;
+        if (s.hybrid)
+            s.atomCycles = 0.0;
+        for (std::size_t gi = 0; gi < groups.size(); ++gi)
+        {
+            const Group &g = groups[gi];
+            if (g.fd[PERF_CYCLES] < 0)
+                continue;
+            // nr, time_enabled, time_running y un valor por miembro del grupo
+            std::uint64_t buf[3 + PERF_EVENT_COUNT] = {};
+            if (::read(g.fd[PERF_CYCLES], buf, sizeof(buf)) < ssize_t(3 * sizeof(std::uint64_t)))
+                continue;
+            double scale = buf[2] > 0 ? double(buf[1]) / double(buf[2]) : 0.0;
+            for (int e = 0, slot = 0; e < PERF_EVENT_COUNT; ++e)
+            {
+                if (g.fd[e] < 0)
+                    continue;
+                double v = double(buf[3 + slot++]) * scale;
+                s.counts[e] = (s.counts[e] < 0.0 ? 0.0 : s.counts[e]) + v;
+                if (e == PERF_CYCLES && s.hybrid && pmuTypes[gi % pmuTypes.size()] == atomType)
+                    s.atomCycles += v;
+            }
+        }
+        return s;
+    }
+
+private:
+    struct Group
+    {
+        int fd[PERF_EVENT_COUNT] = {-1, -1, -1, -1};
+    };
+
+    static long perfEventOpen(perf_event_attr *attr, pid_t pid, int cpu, int groupFd, unsigned long flags)
+    {
+        return syscall(__NR_perf_event_open, attr, pid, cpu, groupFd, flags);
+    }
+
+    static int readPmuType(const char *name)
+    {
+        std::ifstream in(std::string("/sys/bus/event_source/devices/") + name + "/type");
+        int t = -1;
+        in >> t;
+        return t;
+    }
+
+    // Tipos de PMU de núcleos de rendimiento y eficientes; vacío si la CPU no es híbrida
+    std::vector<std::uint64_t> hybridPmuTypes()
+    {
+        int core = readPmuType("cpu_core"), atom = readPmuType("cpu_atom");
+        if (core < 0 || atom < 0)
+            return {};
+        atomType = std::uint64_t(atom);
+        return {std::uint64_t(core), std::uint64_t(atom)};
+    }
+
+    // Grupo del hilo actual: ciclos como líder y el resto como miembros; pmuType 0
+    // es el PMU por defecto
+    static void openGroup(Group &g, std::uint64_t pmuType)
+    {
+        static const std::uint64_t configs[PERF_EVENT_COUNT] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int e = 0; e < PERF_EVENT_COUNT; ++e)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = (pmuType << 32) | configs[e];
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.disabled = (e == PERF_CYCLES);
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            g.fd[e] = int(perfEventOpen(&attr, 0, -1, e == PERF_CYCLES ? -1 : g.fd[PERF_CYCLES], 0));
+            // Sin líder no hay grupo
+            if (e == PERF_CYCLES && g.fd[e] < 0)
+                return;
+        }
+    }
+
+    bool requested;
+    std::vector<std::uint64_t> pmuTypes;
+    std::uint64_t atomType = 0;
+    std::vector<Group> groups;
+};
@@ -0,0 +1,131 @@
+/**
+ * @file phase_timers.h
+ * @brief Temporizadores por etapa del bucle generacional (selección, cruce, mutación,
+ *        evaluación y gestión), como política de GeneticAlgorithm (ga_engine.h).
+ *
+ * PhaseTimers acumula ticks y llamadas por etapa en una ranura por trabajador del
+ * pool (alineada a línea de caché, sin contención entre hilos). En x86 los ticks son
+ * del TSC (rdtsc, unas decenas de ciclos por lectura frente a miles por pareja) y se
+ * pasan a segundos al final de la ejecución calibrando contra steady_clock; en otras
+ * arquitecturas son nanosegundos de steady_clock.
+ *
+ * NoPhaseTimers tiene la misma interfaz vacía y es la que usan los binarios salvo que
+ * se compilen con -DPARADISEO_PHASE_TIMERS (problems.h): así la instrumentación
+ * desaparece por completo cuando no se pide.
+ *
+ * Las etapas se miden por pareja, salvo la evaluación por lotes (una vez por bloque de
+ * cada hilo) y la gestión (élites, intercambio de búferes, estadísticas y criterio de
+ * parada, una vez por generación en el hilo que llama). Los segundos de las etapas
+ * que se reparten entre hilos son la suma de todos los hilos.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+enum GaStage
+{
+    STAGE_SELECTION,  // torneos y copia de los padres sobre las filas de los hijos
+    STAGE_CROSSOVER,  // sorteo y cruce de la pareja
+    STAGE_MUTATION,   // mutación de los dos hijos
+    STAGE_EVALUATION, // evaluación de los hijos (por lotes o hijo a hijo)
+    STAGE_BOOKKEEPING,
+    STAGE_COUNT
+};
+
+inline const char *gaStageName(GaStage s)
+{
+    static const char *names[] = {"seleccion", "cruce", "mutacion", "evaluacion", "gestion"};
+    return names[s];
+}
+
+// Tiempo acumulado y número de llamadas de cada etapa en una ejecución
+struct StageProfile
+{
+    bool enabled = false;
+    double seconds[STAGE_COUNT] = {};
+    std::uint64_t calls[STAGE_COUNT] = {};
+};
+
+// ----------------------------------------------------
+// Sin instrumentación: todo se resuelve en compilación a nada
+// ----------------------------------------------------
+struct NoPhaseTimers
+{
+    void start(std::size_t) {}
+    std::uint64_t now() const { return 0; }
+    std::uint64_t lap(std::size_t, GaStage, std::uint64_t, std::uint64_t = 1) { return 0; }
+    StageProfile finish() { return StageProfile(); }
+};
+
+// ----------------------------------------------------
+// Instrumentación por etapas
+// ----------------------------------------------------
+class PhaseTimers
+{
+public:
+    // Pone a cero los contadores para workers trabajadores y empieza la calibración
+    void start(std::size_t workers)
+    {
+        slots.assign(workers ? workers : 1, Slot());
+        wall0 = std::chrono::steady_clock::now();
+        tick0 = ticks();
+    }
+
+    std::uint64_t now() const { return ticks(); }
+
+    // Carga a la etapa s del trabajador w el tiempo desde t0 y calls llamadas;
+    // devuelve el instante actual para encadenar etapas
+    std::uint64_t lap(std::size_t w, GaStage s, std::uint64_t t0, std::uint64_t calls = 1)
+    {
+        std::uint64_t t = ticks();
+        slots[w].ticks[s] += t - t0;
+        slots[w].calls[s] += calls;
+        return t;
+    }
+
+    // Suma los trabajadores y pasa los ticks a segundos
+    StageProfile finish()
+    {
+        double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall0).count();
+        std::uint64_t elapsed = ticks() - tick0;
+        double secondsPerTick = elapsed > 0 ? wall / double(elapsed) : 0.0;
+
+        StageProfile p;
+        p.enabled = true;
+        for (const Slot &sl : slots)
+            for (int s = 0; s < STAGE_COUNT; ++s)
+            {
+                p.seconds[s] += double(sl.ticks[s]) * secondsPerTick;
+                p.calls[s] += sl.calls[s];
+            }
+        return p;
+    }
+
+private:
+    struct alignas(64) Slot
+    {
+        std::uint64_t ticks[STAGE_COUNT] = {};
+        std::uint64_t calls[STAGE_COUNT] = {};
+    };
+
+    static std::uint64_t ticks()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now().time_since_epoch())
+                                 .count());
+#endif
+    }
+
+    std::vector<Slot> slots;
+    std::chrono::steady_clock::time_point wall0;
+    std::uint64_t tick0 = 0;
+};
@@ -0,0 +1,242 @@
+/**
+ * @file problems.h
+ * @brief Los cuatro problemas de prueba como políticas de GeneticAlgorithm
+ *        (ga_engine.h) y las instancias del motor que usan los binarios.
+ *
+ * Los problemas reales comparten RealProblem<Derived> (CRTP): inicialización
+ * uniforme en [LOWER, UPPER], evaluación con el núcleo SIMD elegido al arrancar
+ * (simd_kernels.h) y paso del valor bruto (a minimizar) al fitness (a maximizar).
+ * Cada problema solo aporta sus límites, sus núcleos y su normalización, que el
+ * compilador resuelve sin llamadas virtuales. Los evaluadores son funciones puras
+ * del genoma; las estadísticas las reduce el motor después de cada generación.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "bit_operators.h"
+#include "bit_population.h"
+#include "counter_rng.h"
+#include "ga_engine.h"
+#include "phase_timers.h"
+#include "real_operators.h"
+#include "real_population.h"
+#include "simd_kernels.h"
+
+// ----------------------------------------------------
+// Base común de los problemas reales
+// Derived aporta LOWER, UPPER, rawValue(x, n), rawRows(...) y score(raw); si el valor
+// bruto se recorta, también clampRaw(raw)
+// ----------------------------------------------------
+template <class Derived>
+class RealProblem
+{
+public:
+    explicit RealProblem(std::size_t dim) : d(dim) {}
+
+    std::size_t dim() const { return d; }
+
+    // Distribución uniforme en todo el rango
+    template <class Ind, class Rng>
+    void init(Ind &ind, Rng &gen) const
+    {
+        fillUniform(gen, ind.x.data(), ind.x.size(), Derived::LOWER, Derived::UPPER);
+    }
+
+    // Valor bruto que se guarda y se puntúa; por defecto, el calculado
+    double clampRaw(double raw) const { return raw; }
+
+    template <class Ind>
+    void evaluate(Ind &ind) const
+    {
+        const double raw = self().clampRaw(self().rawValue(ind.x.data(), ind.x.size()));
+        ind.fitness(self().score(raw));
+        ind.raw_value = raw;
+    }
+
+    // Evalúa en un solo lote las filas [begin, end) de una población SoA; da los
+    // mismos valores que evaluate() individuo a individuo
+    template <class Pop>
+    void evaluateRows(Pop &pop, std::size_t begin, std::size_t end) const
+    {
+        if (begin >= end)
+            return;
+        double *raw = pop.rawData();
+        double *fit = pop.fitnessData();
+        self().rawRows(pop.row(begin), pop.rowStride(), pop.dim(), end - begin, raw + begin);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            raw[i] = self().clampRaw(raw[i]);
+            fit[i] = self().score(raw[i]);
+        }
+    }
+
+private:
+    const Derived &self() const { return static_cast<const Derived &>(*this); }
+
+    std::size_t d;
+};
+
+// ----------------------------------------------------
+// Sphere: suma de cuadrados escalada a [0,1]
+// ----------------------------------------------------
+class SphereProblem : public RealProblem<SphereProblem>
+{
+public:
+    static constexpr double LOWER = -5.12;
+    static constexpr double UPPER = 5.12;
+
+    explicit SphereProblem(std::size_t dim = 1024) : RealProblem(dim), fmax(dim * UPPER * UPPER) {}
+
+    double rawValue(const double *x, std::size_t n) const { return realKernels().sumSquares(x, n); }
+    void rawRows(const double *rows, std::size_t stride, std::size_t dim, std::size_t n, double *out) const
+    {
+        realKernels().sumSquaresRows(rows, stride, dim, n, out);
+    }
+    double score(double raw) const { return 1.0 - raw / fmax; }
+
+    // Criterio original de sphere_sbx: el fitness está en [0,1], así que en la
+    // práctica siempre para por tiempo
+    bool solved(const GaResult &r) const { return r.bestFitness >= 100.0; }
+
+private:
+    double fmax;
+};
+
+// ----------------------------------------------------
+// Base de Schwefel y Rosenbrock: valor bruto recortado a WORST_CASE_VALUE y
+// normalización invertida limitada a [0,1] (0 = peor, 1 = mejor)
+// ----------------------------------------------------
+template <class Derived>
+class ClippedRealProblem : public RealProblem<Derived>
+{
+public:
+    static constexpr double WORST_CASE_VALUE = 1e10;
+
+    ClippedRealProblem(std::size_t dim, double fmax) : RealProblem<Derived>(dim), fmax(fmax) {}
+
+    // Limitar valores extremos para evitar problemas numéricos
+    double clampRaw(double raw) const { return raw > WORST_CASE_VALUE ? WORST_CASE_VALUE : raw; }
+
+    double score(double raw) const { return std::max(0.0, std::min(1.0, 1.0 - raw / fmax)); }
+
+    // Convergencia perfecta (muy improbable con 1024 dimensiones)
+    bool solved(const GaResult &r) const { return r.bestRaw < 1e-10; }
+
+private:
+    double fmax;
+};
+
+// Schwefel: 418.9829*d - sum(x_i * sin(sqrt(|x_i|))); óptimo en x_i = 420.9687
+class SchwefelProblem : public ClippedRealProblem<SchwefelProblem>
+{
+public:
+    static constexpr double LOWER = -500.0;
+    static constexpr double UPPER = 500.0;
+
+    explicit SchwefelProblem(std::size_t dim = 1024) : ClippedRealProblem(dim, dim * 1000.0) {}
+
+    double rawValue(const double *x, std::size_t n) const { return realKernels().schwefel(x, n); }
+    void rawRows(const double *rows, std::size_t stride, std::size_t dim, std::size_t n, double *out) const
+    {
+        realKernels().schwefelRows(rows, stride, dim, n, out);
+    }
+};
+
+// Rosenbrock: sum(100 (x_{i+1} - x_i^2)^2 + (1 - x_i)^2); óptimo en x_i = 1
+class RosenbrockProblem : public ClippedRealProblem<RosenbrockProblem>
+{
+public:
+    static constexpr double LOWER = -5.12;
+    static constexpr double UPPER = 5.12;
+
+    explicit RosenbrockProblem(std::size_t dim = 1024) : ClippedRealProblem(dim, dim * 40000.0) {}
+
+    double rawValue(const double *x, std::size_t n) const { return realKernels().rosenbrock(x, n); }
+    void rawRows(const double *rows, std::size_t stride, std::size_t dim, std::size_t n, double *out) const
+    {
+        realKernels().rosenbrockRows(rows, stride, dim, n, out);
+    }
+};
+
+// ----------------------------------------------------
+// OneMax: fitness = número de 1 (popcount, packed_bits.h); el valor bruto es el
+// número de 0, es decir, la distancia al óptimo
+// ----------------------------------------------------
+class OneMaxProblem
+{
+public:
+    explicit OneMaxProblem(std::size_t nbits = 1024) : nbits(nbits) {}
+
+    std::size_t dim() const { return nbits; }
+
+    // Cada bit se inicializa a true con probabilidad 0.5: cada llamada
+    // a rand() aporta 32 bits equiprobables, dos por palabra
+    template <class Ind, class Rng>
+    void init(Ind &ind, Rng &gen) const
+    {
+        BitSpan::Word *w = ind.bits.data();
+        for (std::size_t i = 0; i < ind.bits.nwords(); ++i)
+        {
+            BitSpan::Word hi = gen.rand();
+            w[i] = (hi << 32) | gen.rand();
+        }
+        ind.bits.clearPadding();
+    }
+
+    template <class Ind>
+    void evaluate(Ind &ind) const
+    {
+        std::size_t count = ind.bits.count();
+        ind.fitness(double(count));
+        ind.raw_value = double(nbits - count);
+    }
+
+    template <class Pop>
+    void evaluateRows(Pop &pop, std::size_t begin, std::size_t end) const
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            auto ind = pop[i];
+            evaluate(ind);
+        }
+    }
+
+    bool solved(const GaResult &r) const { return r.bestFitness >= double(nbits); }
+
+private:
+    std::size_t nbits;
+};
+
+// ----------------------------------------------------
+// Instancias del motor para los cuatro problemas. Dim fija la longitud del genoma
+// en compilación (genome_extent.h); los binarios usan BENCH_DIM y las demás
+// longitudes van por las versiones dinámicas
+// ----------------------------------------------------
+static constexpr std::size_t BENCH_DIM = 1024;
+
+// Temporizadores por etapa (phase_timers.h): solo si se compila con -DPARADISEO_PHASE_TIMERS
+#ifdef PARADISEO_PHASE_TIMERS
+typedef PhaseTimers BenchTimers;
+#else
+typedef NoPhaseTimers BenchTimers;
+#endif
+
+template <std::size_t Dim>
+using BasicOneMaxGA = GeneticAlgorithm<BasicBitPopulation<Dim>, OneMaxProblem, OnePointCrossover, BitFlipMutation,
+                                       TournamentSelection, BenchTimers>;
+template <std::size_t Dim>
+using BasicSphereGA = GeneticAlgorithm<BasicRealPopulation<Dim>, SphereProblem, SBXCrossover, PolyMutation,
+                                       TournamentSelection, BenchTimers>;
+template <std::size_t Dim>
+using BasicSchwefelGA = GeneticAlgorithm<BasicRealPopulation<Dim>, SchwefelProblem, SafeSBXCrossover, RealMutation,
+                                         TournamentSelection, BenchTimers>;
+template <std::size_t Dim>
+using BasicRosenbrockGA = GeneticAlgorithm<BasicRealPopulation<Dim>, RosenbrockProblem, SafeSBXCrossover, RealMutation,
+                                           TournamentSelection, BenchTimers>;
+
+typedef BasicOneMaxGA<BENCH_DIM> OneMaxGA;
+typedef BasicSphereGA<BENCH_DIM> SphereGA;
+typedef BasicSchwefelGA<BENCH_DIM> SchwefelGA;
+typedef BasicRosenbrockGA<BENCH_DIM> RosenbrockGA;
@@ -0,0 +1,211 @@
+/**
+ * @file real_operators.h
+ * @brief Operadores de variación sobre vectores reales: SBX (Sphere), SBX "seguro" y
+ *        mutación gaussiana estilo DEAP (Schwefel, Rosenbrock) y mutación polinómica.
+ *
+ * Sirven para cualquier individuo con ind.x (GeneSpan), como las vistas de
+ * RealPopulation. Los números aleatorios se sortean en bloques de VARIATION_CHUNK
+ * genes (counter_rng.h) y el cálculo lo hacen los núcleos vectorizados de
+ * variation_kernels.h. apply() devuelve si ha modificado algún genoma.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "counter_rng.h"
+#include "mutation_sites.h"
+#include "variation_kernels.h"
+
+// ----------------------------------------------------
+// SBX Crossover
+// Un u por gen, sorteados de una vez por bloque
+// ----------------------------------------------------
+struct SBXCrossover
+{
+    double eta, lo, hi;
+    SBXCrossover(double _eta, double _lo, double _hi) : eta(_eta), lo(_lo), hi(_hi) {}
+
+    template <class Ind, class Rng>
+    bool apply(Ind &a, Ind &b, Rng &gen) const
+    {
+        const std::size_t n = a.x.size();
+        double u[VARIATION_CHUNK];
+        for (std::size_t off = 0; off < n; off += VARIATION_CHUNK)
+        {
+            std::size_t m = std::min(VARIATION_CHUNK, n - off);
+            fillUniform(gen, u, m);
+            variationKernels().sbx(a.x.data() + off, b.x.data() + off, u, m, eta, lo, hi);
+        }
+        return true;
+    }
+};
+
+// ----------------------------------------------------
+// SBX "seguro": los genes que no se cruzan (|a - b| < 1e-10) reciben u = 0 y el
+// núcleo vectorizado sin ramas los deja intactos
+// ----------------------------------------------------
+struct SafeSBXCrossover
+{
+    double eta, lo, hi;
+    SafeSBXCrossover(double _eta, double _lo, double _hi) : eta(_eta), lo(_lo), hi(_hi) {}
+
+    template <class Ind, class Rng>
+    bool apply(Ind &a, Ind &b, Rng &gen) const
+    {
+        const std::size_t n = a.x.size();
+        double u[VARIATION_CHUNK];
+        for (std::size_t off = 0; off < n; off += VARIATION_CHUNK)
+        {
+            std::size_t m = std::min(VARIATION_CHUNK, n - off);
+            fillUniform(gen, u, m);
+            for (std::size_t i = 0; i < m; ++i)
+            {
+                if (std::abs(a.x[off + i] - b.x[off + i]) < 1e-10)
+                    u[i] = 0.0;
+            }
+            variationKernels().safeSbx(a.x.data() + off, b.x.data() + off, u, m, eta, lo, hi);
+        }
+        return true;
+    }
+};
+
+// ----------------------------------------------------
+// Mutación polinómica
+// Con skipSampling los genes a mutar se eligen por saltos geométricos (mutation_sites.h);
+// si no, se sortea en bloque una moneda por gen. Las posiciones y sus u se recogen
+// en orden y los desplazamientos se calculan en bloque con el núcleo vectorizado
+// ----------------------------------------------------
+struct PolyMutation
+{
+    double pm, eta, lo, hi;
+    bool skipSampling;
+    GeometricSiteSampler sites;
+    PolyMutation(double _pm, double _eta, double _lo, double _hi, bool _skipSampling = false)
+        : pm(_pm), eta(_eta), lo(_lo), hi(_hi), skipSampling(_skipSampling), sites(_pm) {}
+
+    template <class Ind, class Rng>
+    bool apply(Ind &ind, Rng &gen) const
+    {
+        // Copias locales: las escrituras en los genes podrían solaparse con los miembros
+        const double lo = this->lo, hi = this->hi, pm = this->pm;
+        std::size_t idx[VARIATION_CHUNK];
+        double u[VARIATION_CHUNK], delta[VARIATION_CHUNK], coin[VARIATION_CHUNK];
+        std::size_t m = 0;
+        bool mutated = false;
+        auto flush = [&]
+        {
+            variationKernels().polyDelta(u, m, eta, delta);
+            for (std::size_t j = 0; j < m; ++j)
+            {
+                double v = ind.x[idx[j]] + delta[j] * (hi - lo);
+                ind.x[idx[j]] = std::min(std::max(v, lo), hi);
+            }
+            m = 0;
+        };
+        auto site = [&](std::size_t i)
+        {
+            idx[m] = i;
+            u[m] = gen.uniform();
+            mutated = true;
+            if (++m == VARIATION_CHUNK)
+                flush();
+        };
+        const std::size_t n = ind.x.size();
+        if (skipSampling)
+            sites.forEach(n, gen, site);
+        else
+        {
+            for (std::size_t off = 0; off < n; off += VARIATION_CHUNK)
+            {
+                std::size_t c = std::min(VARIATION_CHUNK, n - off);
+                fillUniform(gen, coin, c);
+                for (std::size_t i = 0; i < c; ++i)
+                {
+                    if (coin[i] < pm)
+                        site(off + i);
+                }
+            }
+        }
+        flush();
+        return mutated;
+    }
+};
+
+// ----------------------------------------------------
+// Mutación estilo DEAP para valores reales: con probabilidad p_ind se muta el
+// individuo y entonces cada gen con probabilidad p_bit, sumándole una normal de
+// desviación sigma = 10% del rango y recortando a los límites.
+// Las posiciones a mutar se recogen en bloques de VARIATION_CHUNK y sus
+// normales se sortean de una vez (fillNormal, counter_rng.h)
+// ----------------------------------------------------
+struct RealMutation
+{
+    double p_ind, p_bit, lo, hi, sigma;
+    // Con skipSampling los genes a mutar se eligen por saltos geométricos (mutation_sites.h)
+    bool skipSampling;
+    GeometricSiteSampler sites;
+
+    RealMutation(double _p_ind, double _p_bit, double _lo, double _hi, bool _skipSampling = false)
+        : p_ind(_p_ind), p_bit(_p_bit), lo(_lo), hi(_hi), sigma((_hi - _lo) * 0.1),
+          skipSampling(_skipSampling), sites(_p_bit) {}
+
+    // Mutación gaussiana de un gen con la normal estándar z ya sorteada
+    template <class Ind>
+    void mutateGene(Ind &ind, std::size_t i, double z) const
+    {
+        double delta = z * sigma;
+        ind.x[i] += delta;
+
+        // Asegurar que se mantiene dentro de límites
+        ind.x[i] = std::max(lo, std::min(hi, ind.x[i]));
+    }
+
+    template <class Ind, class Rng>
+    bool apply(Ind &ind, Rng &gen) const
+    {
+        // Paso 1: ¿se muta el individuo?
+        if (!(gen.uniform() < p_ind))
+            return false;
+
+        std::size_t idx[VARIATION_CHUNK];
+        double z[VARIATION_CHUNK], coin[VARIATION_CHUNK];
+        std::size_t m = 0;
+        bool mutated = false;
+        auto flush = [&]
+        {
+            fillNormal(gen, z, m);
+            for (std::size_t j = 0; j < m; ++j)
+                mutateGene(ind, idx[j], z[j]);
+            m = 0;
+        };
+        auto site = [&](std::size_t i)
+        {
+            idx[m] = i;
+            mutated = true;
+            if (++m == VARIATION_CHUNK)
+                flush();
+        };
+
+        const std::size_t n = ind.x.size();
+        if (skipSampling)
+            sites.forEach(n, gen, site);
+        else
+        {
+            // Paso 2: para cada gen, decide si mutar (una moneda por gen, en bloque)
+            for (std::size_t off = 0; off < n; off += VARIATION_CHUNK)
+            {
+                std::size_t c = std::min(VARIATION_CHUNK, n - off);
+                fillUniform(gen, coin, c);
+                for (std::size_t i = 0; i < c; ++i)
+                {
+                    if (coin[i] < p_bit)
+                        site(off + i);
+                }
+            }
+        }
+        flush();
+        return mutated;
+    }
+};
@@ -0,0 +1,123 @@
+/**
+ * @file real_population.h
+ * @brief Población de individuos reales en formato estructura de arrays (SoA).
+ *
+ * En lugar de N objetos con su propio vector<double> en el montón, la población es
+ * una única matriz N×D de genes alineada a 64 bytes (cada fila empieza en línea de
+ * caché) más dos arrays contiguos de fitness y raw_value. La memoria ocupada es
+ * exactamente bytesFor(N, D), lo que permite dimensionar las ejecuciones de antemano.
+ *
+ * RealIndividualView expone un individuo con la interfaz que usan los operadores
+ * reales (real_operators.h) y los problemas (problems.h): ind.x[i], ind.x.size(),
+ * ind.fitness(v) e ind.raw_value.
+ *
+ * BasicRealPopulation<Dim> fija la dimensión en compilación (genome_extent.h): la
+ * separación entre filas, las copias y la longitud de las vistas pasan a ser
+ * constantes. RealPopulation es la versión de dimensión dinámica.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "aligned_allocator.h"
+#include "genome_extent.h"
+
+// Tramo de genes de un individuo (puntero + longitud)
+template <std::size_t Dim = DYNAMIC_DIM>
+class BasicGeneSpan : private GenomeExtent<Dim>
+{
+public:
+    BasicGeneSpan(double *p, std::size_t n) : GenomeExtent<Dim>(n), p(p) {}
+    std::size_t size() const { return this->value(); }
+    double *data() const { return p; }
+    double &operator[](std::size_t i) const { return p[i]; }
+    double *begin() const { return p; }
+    double *end() const { return p + size(); }
+
+private:
+    double *p;
+};
+
+typedef BasicGeneSpan<> GeneSpan;
+
+// Vista ligera de un individuo dentro de RealPopulation
+template <std::size_t Dim = DYNAMIC_DIM>
+struct BasicRealIndividualView
+{
+    BasicGeneSpan<Dim> x;
+    double &raw_value;
+    double &fit;
+
+    double fitness() const { return fit; }
+    void fitness(double f) { fit = f; }
+};
+
+typedef BasicRealIndividualView<> RealIndividualView;
+
+template <std::size_t Dim = DYNAMIC_DIM>
+class BasicRealPopulation : private GenomeExtent<Dim>
+{
+public:
+    // Dobles por línea de caché: cada fila se rellena hasta un múltiplo de 8
+    static constexpr std::size_t LINE_DOUBLES = 64 / sizeof(double);
+
+    BasicRealPopulation(std::size_t n, std::size_t dim)
+        : GenomeExtent<Dim>(dim), n(n), genes(n * strideFor(dim), 0.0), fit(n, 0.0), raw(n, 0.0) {}
+
+    std::size_t size() const { return n; }
+    std::size_t dim() const { return this->value(); }
+    // Separación en dobles entre filas consecutivas (para los núcleos por lotes)
+    std::size_t rowStride() const { return strideFor(dim()); }
+
+    double *row(std::size_t i) { return genes.data() + i * rowStride(); }
+    const double *row(std::size_t i) const { return genes.data() + i * rowStride(); }
+    double *fitnessData() { return fit.data(); }
+    const double *fitnessData() const { return fit.data(); }
+    double *rawData() { return raw.data(); }
+    const double *rawData() const { return raw.data(); }
+
+    BasicRealIndividualView<Dim> operator[](std::size_t i)
+    {
+        return BasicRealIndividualView<Dim>{BasicGeneSpan<Dim>(row(i), dim()), raw[i], fit[i]};
+    }
+
+    // Copia el individuo src[j] (genes, fitness y raw_value) sobre la posición i
+    void copyFrom(std::size_t i, const BasicRealPopulation &src, std::size_t j)
+    {
+        std::memcpy(row(i), src.row(j), dim() * sizeof(double));
+        fit[i] = src.fit[j];
+        raw[i] = src.raw[j];
+    }
+
+    // Intercambio O(1) de las reservas de memoria (doble búfer)
+    void swap(BasicRealPopulation &other)
+    {
+        std::swap(static_cast<GenomeExtent<Dim> &>(*this), static_cast<GenomeExtent<Dim> &>(other));
+        std::swap(n, other.n);
+        genes.swap(other.genes);
+        fit.swap(other.fit);
+        raw.swap(other.raw);
+    }
+
+    // Memoria ocupada por una población de n individuos de dimensión dim
+    static std::size_t bytesFor(std::size_t n, std::size_t dim)
+    {
+        return n * (strideFor(dim) + 2) * sizeof(double);
+    }
+
+private:
+    static constexpr std::size_t strideFor(std::size_t dim)
+    {
+        return (dim + LINE_DOUBLES - 1) / LINE_DOUBLES * LINE_DOUBLES;
+    }
+
+    std::size_t n;
+    std::vector<double, AlignedAllocator<double, 64>> genes;
+    std::vector<double, AlignedAllocator<double, 64>> fit;
+    std::vector<double, AlignedAllocator<double, 64>> raw;
+};
+
+typedef BasicRealPopulation<> RealPopulation;
@@ -0,0 +1,344 @@
+/**
+ * @file result_rows.h
+ * @brief Filas de resultados de cada problema, con el formato de CSV de los binarios
+ *        originales (onemax, sphere_sbx, schwefel, rosenbrock).
+ *
+ * Las usan tanto los binarios de cada problema como el modo campaña de ea_bench
+ * (campaign.h), de modo que una ejecución dentro de una campaña deja exactamente la
+ * misma fila, en el mismo fichero, que la ejecución suelta del binario.
+ *
+ * Además cada ejecución, de cualquier binario, añade una fila con el esquema común de
+ * resultStoreRow() al almacén por columnas resultados_<host> (result_store.h; otro
+ * directorio con PARADISEO_RESULTS=<directorio>), que es seguro con varias ejecuciones
+ * a la vez y se lee sin analizar texto. Los contadores hardware y el tiempo por etapa
+ * van en columnas de esa misma fila. Los CSV de cada problema se siguen escribiendo
+ * para los cuadernos de análisis actuales, salvo con PARADISEO_CSV=0.
+ */
+#pragma once
+
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <unistd.h>
+
+#include "cpu_features.h"
+#include "energy_meter.h"
+#include "ga_engine.h"
+#include "perf_counters.h"
+#include "result_store.h"
+
+// Una ejecución terminada y los parámetros que aparecen en su fila
+struct RunRecord
+{
+    std::string problem; // onemax, sphere, schwefel o rosenbrock
+    std::size_t dim = 1024;
+    std::size_t popSize = 0;
+    double crossoverRate = 0.0;
+    // Probabilidad de mutación (por individuo en Schwefel y Rosenbrock) y por gen
+    double mutationRate = 0.0;
+    double mutationBitRate = 0.0;
+    int runId = 1;
+    std::size_t threads = 1;
+    // Resto de la configuración del bucle (GaConfig)
+    std::uint32_t seed = 0;
+    std::size_t eliteCount = 0;
+    bool steadyState = false;
+    SteadyReplacement replacement = REPLACE_WORST;
+    double targetFitness = DBL_MAX;
+    // Islas (islands.h): islands = 1 sin islas; island es la isla del proceso con
+    // ea_bench -shm (-1 en los demás casos)
+    std::size_t islands = 1;
+    std::size_t migrationInterval = 0;
+    std::size_t migrants = 0;
+    std::string topology = "-";
+    int island = -1;
+    // Fecha y hora de inicio
+    std::time_t started = 0;
+    // Energía consumida en cada fase (energy_meter.h); todo 0 si no se ha medido
+    EnergyReading energy[PHASE_COUNT];
+    GaResult result;
+    // Energía del bucle hasta alcanzar targetFitness (-1: no se alcanzó o no se midió)
+    double targetJoules = -1.0;
+    // Contadores hardware del bucle (perf_counters.h); requested = false si no se pidieron
+    PerfSample counters;
+
+    EnergyReading totalEnergy() const
+    {
+        EnergyReading t;
+        for (const EnergyReading &e : energy)
+            t += e;
+        return t;
+    }
+};
+
+// Nombre de la máquina ("desconocido" si no se puede leer)
+inline std::string hostName()
+{
+    char host[256];
+    if (gethostname(host, sizeof(host)) != 0)
+        return "desconocido";
+    host[sizeof(host) - 1] = '\0';
+    return std::string(host);
+}
+
+inline std::string formatTime(std::time_t t, const char *fmt)
+{
+    char buf[100];
+    std::strftime(buf, sizeof(buf), fmt, std::localtime(&t));
+    return std::string(buf);
+}
+
+inline const char *stopReasonName(StopReason stop)
+{
+    switch (stop)
+    {
+    case STOP_SOLVED:
+        return "solved";
+    case STOP_MAX_GENERATIONS:
+        return "max_generations";
+    case STOP_CANCELLED:
+        return "cancelled";
+    default:
+        return "timeout";
+    }
+}
+
+inline const char *replacementName(SteadyReplacement r)
+{
+    return r == REPLACE_REVERSE_TOURNAMENT ? "torneo" : "peor";
+}
+
+// Fichero de resultados de cada problema
+inline std::string resultsFileName(const std::string &problem)
+{
+    if (problem == "onemax")
+        return "onemax_resultados.csv";
+    if (problem == "sphere")
+        return "sphere_results.csv";
+    return "resultados_" + problem + "_paradiseo_" + hostName() + ".csv";
+}
+
+// ----------------------------------------------------
+// OneMax: tiempo en milisegundos, fitness entero
+// ----------------------------------------------------
+inline void appendOneMaxRow(const RunRecord &rec)
+{
+    const GaResult &r = rec.result;
+    const char *stop = (r.stop == STOP_SOLVED)    ? "Fitness alcanzado"
+                       : (r.stop == STOP_TIMEOUT) ? "Timeout de 2 minutos"
+                                                  : "Fin de generaciones";
+    int fitnessInitial = (int)r.initialBestFitness;
+    int bestFitness = (int)r.bestFitness;
+
+    std::ofstream csv(resultsFileName(rec.problem), std::ios::app);
+    // Si el archivo está vacío, escribir la cabecera
+    if (csv.tellp() == 0)
+    {
+        csv << "ID,Fecha_Hora,Framework,Tamano_individuo,Tamano_Poblacion,Prob_Cruce,Prob_Mutacion,Gen_Alcanzada,Fitness_Inicial,Variacion_Fitness,Fitness_Final,Tiempo_Ejecucion,Gen_Fitness_Max,Fitness_Max,Motivo_Parada,Donde_Ejecutado\n";
+    }
+    csv << rec.runId << ","
+        << formatTime(rec.started, "%Y-%m-%d %H:%M:%S") << ","
+        << "Paradiseo" << ","
+        << rec.dim << ","
+        << rec.popSize << ","
+        << rec.crossoverRate << ","
+        << rec.mutationRate << ","
+        << r.generations << ","
+        << fitnessInitial << ","
+        << bestFitness - fitnessInitial << ","
+        << bestFitness << ","
+        << std::floor(r.seconds * 1000.0) / 1000.0 << ","
+        << r.bestGeneration << ","
+        << bestFitness << ","
+        << stop << ","
+        << hostName() << "\n";
+}
+
+// ----------------------------------------------------
+// Sphere: tiempo en segundos enteros
+// ----------------------------------------------------
+inline void appendSphereRow(const RunRecord &rec)
+{
+    const GaResult &r = rec.result;
+    std::ofstream csv(resultsFileName(rec.problem), std::ios::app);
+    if (csv.tellp() == 0)
+        csv << "fecha_hora,framework,tamanio_individuo,poblacion,cruce,mutacion,generacion,fitness_inicial,variacion_fitness,fitness_maximo,generacion_mejor,tiempo_transcurrido,motivo_parada,ubicacion_ejecucion\n";
+
+    csv << formatTime(rec.started, "%Y-%m-%d_%H-%M-%S") << ","          // fecha_hora
+        << "Paradiseo" << ","                                          // framework
+        << rec.dim << ","                                              // tamanio_individuo
+        << rec.popSize << ","                                          // poblacion
+        << rec.crossoverRate << ","                                    // cruce
+        << rec.mutationRate << ","                                     // mutacion
+        << r.generations << ","                                        // generacion
+        << r.initialBestFitness << ","                                 // fitness_inicial
+        << r.bestFitness - r.initialBestFitness << ","                 // variacion_fitness
+        << r.bestFitness << ","                                        // fitness_maximo
+        << r.bestGeneration << ","                                     // generacion_mejor
+        << std::floor(r.seconds) << ","                                // tiempo_transcurrido
+        << (r.stop == STOP_SOLVED ? "convergence" : "timeout") << "," // motivo_parada
+        << hostName() << "\n";                                         // ubicacion_ejecucion
+}
+
+// ----------------------------------------------------
+// Schwefel y Rosenbrock: un fichero por máquina, fitness en tanto por uno / 100
+// y la generación inicial contada como una más. energy_consumed es la energía
+// total (paquete + DRAM) en julios; detrás van la energía de cada fase, la de la
+// DRAM y η = fitness (de 0 a 1) por kWh. Los ficheros creados antes de estas
+// columnas siguen recibiendo filas con el formato antiguo
+// ----------------------------------------------------
+inline void appendRealRow(const RunRecord &rec)
+{
+    const GaResult &r = rec.result;
+    const std::string fileName = resultsFileName(rec.problem);
+
+    // Verificar si el archivo existe para escribir la cabecera
+    std::string header;
+    bool fileExists = bool(std::getline(std::ifstream(fileName), header));
+    bool energyColumns = !fileExists || header.find(",fitness_per_kwh") != std::string::npos;
+    std::ofstream csv(fileName, std::ios::app);
+    if (!fileExists) {
+        csv << "population_size,crossover_rate,mutation_individual_rate,"
+            << "mutation_bit_rate,run,generations,initial_fitness,"
+            << "best_fitness,fitness_variation,time,energy_consumed,"
+            << rec.problem << "_value,worst_" << rec.problem << "_seen,hostname,"
+            << "energy_init,energy_loop,energy_output,energy_dram,fitness_per_kwh\n";
+    }
+    const EnergyReading energy = rec.totalEnergy();
+    csv << rec.popSize << ","                                    // population_size
+        << rec.crossoverRate << ","                              // crossover_rate
+        << rec.mutationRate << ","                               // mutation_individual_rate
+        << rec.mutationBitRate << ","                            // mutation_bit_rate
+        << rec.runId << ","                                      // run
+        << r.generations + 1 << ","                              // generations
+        << r.initialBestFitness / 100 << ","                     // initial_fitness
+        << r.bestFitness / 100 << ","                            // best_fitness
+        << (r.bestFitness - r.initialBestFitness) / 100 << ","   // fitness_variation
+        << std::floor(r.seconds) << ","                          // time
+        << energy.total() << ","                                 // energy_consumed
+        << r.bestRaw << ","                                      // <problema>_value
+        << r.worstRaw << ","                                     // worst_<problema>_seen
+        << hostName();                                           // hostname
+    if (energyColumns)
+    {
+        csv << "," << rec.energy[PHASE_INIT].total()             // energy_init
+            << "," << rec.energy[PHASE_LOOP].total()             // energy_loop
+            << "," << rec.energy[PHASE_OUTPUT].total()           // energy_output
+            << "," << energy.dram                                // energy_dram
+            << "," << fitnessPerKwh(r.bestFitness, energy.total()); // fitness_per_kwh
+    }
+    csv << "\n";
+}
+
+// Directorio del almacén de resultados por columnas (result_store.h)
+inline std::string resultStoreDir()
+{
+    const char *env = std::getenv("PARADISEO_RESULTS");
+    return (env && *env) ? std::string(env) : "resultados_" + hostName();
+}
+
+// Los CSV de siempre, salvo con PARADISEO_CSV=0
+inline bool legacyCsvRequested()
+{
+    const char *env = std::getenv("PARADISEO_CSV");
+    return !(env && std::strcmp(env, "0") == 0);
+}
+
+// ----------------------------------------------------
+// Fila del almacén: el mismo esquema para los cuatro problemas y todos los binarios.
+// Fitness y tiempos sin redondear; lo que no se ha medido va como -1 (energía,
+// contadores hardware de perf_counters.h y tiempo por etapa de phase_timers.h) o NaN
+// (fitness_objetivo sin objetivo)
+// ----------------------------------------------------
+inline StoreRow resultStoreRow(const RunRecord &rec)
+{
+    const GaResult &r = rec.result;
+    const PerfSample &c = rec.counters;
+    const EnergyReading energy = rec.totalEnergy();
+    const bool measured = energy.total() > 0.0;
+
+    StoreRow row;
+    row.integer("fecha_inicio", std::int64_t(rec.started));
+    row.text("problema", 16, rec.problem);
+    row.text("hostname", 64, hostName());
+    row.text("simd", 16, simdLevelName(simdLevel()));
+    row.integer("dimension", std::int64_t(rec.dim));
+    row.integer("poblacion", std::int64_t(rec.popSize));
+    row.real("cruce", rec.crossoverRate);
+    row.real("mutacion", rec.mutationRate);
+    row.real("mutacion_gen", rec.mutationBitRate);
+    row.integer("elites", std::int64_t(rec.eliteCount));
+    row.integer("hilos", std::int64_t(rec.threads));
+    row.integer("semilla", std::int64_t(rec.seed));
+    row.integer("run", rec.runId);
+    row.text("modo", 16, rec.steadyState ? "estacionario" : "generacional");
+    row.text("reemplazo", 16, rec.steadyState ? replacementName(rec.replacement) : "-");
+    row.integer("islas", std::int64_t(rec.islands));
+    row.integer("intervalo_migracion", std::int64_t(rec.islands > 1 ? rec.migrationInterval : 0));
+    row.integer("migrantes", std::int64_t(rec.islands > 1 ? rec.migrants : 0));
+    row.text("topologia", 16, rec.islands > 1 ? rec.topology : "-");
+    row.integer("isla", rec.island);
+    row.integer("generaciones", std::int64_t(r.generations));
+    row.integer("evaluaciones", std::int64_t(r.evaluations));
+    row.integer("evaluaciones_omitidas", std::int64_t(r.skippedEvaluations));
+    row.real("fitness_inicial", r.initialBestFitness);
+    row.real("fitness_mejor", r.bestFitness);
+    row.integer("generacion_mejor", std::int64_t(r.bestGeneration));
+    row.real("fitness_medio", r.meanFitness);
+    row.real("fitness_peor", r.worstFitness);
+    row.real("valor_mejor", r.bestRaw);
+    row.real("valor_peor_visto", r.worstRaw);
+    row.real("tiempo", r.seconds);
+    row.text("motivo_parada", 16, stopReasonName(r.stop));
+    row.real("fitness_objetivo", rec.targetFitness < DBL_MAX ? rec.targetFitness
+                                                               : std::numeric_limits<double>::quiet_NaN());
+    row.real("tiempo_objetivo", r.targetSeconds);
+    row.integer("evaluaciones_objetivo", std::int64_t(r.targetEvaluations));
+    row.real("energia_j", measured ? energy.total() : -1.0);
+    row.real("energia_inicial_j", measured ? rec.energy[PHASE_INIT].total() : -1.0);
+    row.real("energia_bucle_j", measured ? rec.energy[PHASE_LOOP].total() : -1.0);
+    row.real("energia_salida_j", measured ? rec.energy[PHASE_OUTPUT].total() : -1.0);
+    row.real("energia_dram_j", measured ? energy.dram : -1.0);
+    row.real("energia_objetivo_j", rec.targetJoules);
+    row.real("ciclos", c.counts[PERF_CYCLES]);
+    row.real("instrucciones", c.counts[PERF_INSTRUCTIONS]);
+    row.real("fallos_llc", c.counts[PERF_LLC_MISSES]);
+    row.real("fallos_saltos", c.counts[PERF_BRANCH_MISSES]);
+    row.real("ciclos_atom", c.atomCycles);
+    for (int s = 0; s < STAGE_COUNT; ++s)
+    {
+        const std::string stage = std::string("etapa_") + gaStageName(GaStage(s));
+        row.real((stage + "_s").c_str(), r.stages.enabled ? r.stages.seconds[s] : -1.0);
+        row.integer((stage + "_llamadas").c_str(), r.stages.enabled ? std::int64_t(r.stages.calls[s]) : -1);
+    }
+    return row;
+}
+
+// Añade la fila de la ejecución al almacén por columnas; un error se avisa por cerr
+// pero no detiene el programa
+inline void appendStoreResult(const RunRecord &rec)
+{
+    std::string error;
+    if (!appendStoreRow(resultStoreDir(), resultStoreRow(rec), error))
+        std::cerr << "Almacén de resultados: " << error << std::endl;
+}
+
+// Añade la fila de la ejecución al almacén y al fichero de su problema
+inline void appendResultRow(const RunRecord &rec)
+{
+    appendStoreResult(rec);
+    if (!legacyCsvRequested())
+        return;
+    if (rec.problem == "onemax")
+        appendOneMaxRow(rec);
+    else if (rec.problem == "sphere")
+        appendSphereRow(rec);
+    else
+        appendRealRow(rec);
+}
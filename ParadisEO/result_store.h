@@ -0,0 +1,356 @@
+/**
+ * @file result_store.h
+ * @brief Almacén de resultados por columnas: un directorio con un fichero binario por
+ *        columna al que cada ejecución añade su fila bajo un cerrojo, y su lectura
+ *        proyectando los ficheros en memoria (sin analizar texto).
+ *
+ * Disposición del directorio:
+ *
+ *   esquema          una línea "nombre tipo ancho" por columna (i64, f64 o texto)
+ *   filas            número de filas confirmadas (uint64)
+ *   <nombre>.col     los valores de la columna uno detrás de otro, sin cabecera:
+ *                    int64, double o texto de ancho fijo rellenado con '\0'
+ *
+ * Una escritura (appendStoreRow) toma flock(LOCK_EX) sobre `filas`, comprueba que el
+ * esquema es el del almacén (o lo crea si está vacío), escribe el valor de cada
+ * columna en la posición de la fila n y solo al final sube `filas` a n + 1. Varios
+ * procesos pueden escribir a la vez en el mismo almacén, y una escritura cortada a
+ * medias deja colas en algunas columnas que la siguiente recorta y sobrescribe: lo
+ * que cuenta es siempre `filas`.
+ *
+ * ColumnStore lee `filas` con flock(LOCK_SH) y proyecta las n primeras filas de cada
+ * columna: values<double>("tiempo") es directamente el array de la columna. Desde
+ * Python basta numpy.memmap o numpy.fromfile sobre los .col (resultados_paradiseo.py).
+ * Los valores van en el orden de bytes de la máquina que los escribe.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+enum StoreType
+{
+    STORE_INT64,
+    STORE_FLOAT64,
+    STORE_TEXT
+};
+
+inline const char *storeTypeName(StoreType t)
+{
+    return t == STORE_INT64 ? "i64" : t == STORE_FLOAT64 ? "f64" : "texto";
+}
+
+struct StoreColumn
+{
+    std::string name;
+    StoreType type;
+    // Bytes de cada valor (8 en las numéricas)
+    std::size_t width;
+
+    bool operator==(const StoreColumn &o) const { return name == o.name && type == o.type && width == o.width; }
+};
+
+// ----------------------------------------------------
+// Una fila: sus columnas y los bytes de cada valor, en orden
+// ----------------------------------------------------
+class StoreRow
+{
+public:
+    void integer(const char *name, std::int64_t v) { add(name, STORE_INT64, &v, sizeof(v)); }
+    void real(const char *name, double v) { add(name, STORE_FLOAT64, &v, sizeof(v)); }
+
+    // Texto de ancho fijo: se trunca a width bytes
+    void text(const char *name, std::size_t width, const std::string &v)
+    {
+        std::vector<char> buf(width, '\0');
+        std::memcpy(buf.data(), v.data(), std::min(width, v.size()));
+        add(name, STORE_TEXT, buf.data(), width);
+    }
+
+    const std::vector<StoreColumn> &columns() const { return cols; }
+    const unsigned char *value(std::size_t c) const { return data.data() + offsets[c]; }
+
+private:
+    void add(const char *name, StoreType type, const void *v, std::size_t width)
+    {
+        cols.push_back(StoreColumn{name, type, width});
+        offsets.push_back(data.size());
+        const unsigned char *p = static_cast<const unsigned char *>(v);
+        data.insert(data.end(), p, p + width);
+    }
+
+    std::vector<StoreColumn> cols;
+    std::vector<std::size_t> offsets;
+    std::vector<unsigned char> data;
+};
+
+inline std::string storeSchemaText(const std::vector<StoreColumn> &cols)
+{
+    std::ostringstream s;
+    for (const StoreColumn &c : cols)
+        s << c.name << " " << storeTypeName(c.type) << " " << c.width << "\n";
+    return s.str();
+}
+
+// Lee el esquema de dir; false si no existe o no se entiende
+inline bool readStoreSchema(const std::string &dir, std::vector<StoreColumn> &cols)
+{
+    std::ifstream in(dir + "/esquema");
+    if (!in)
+        return false;
+    cols.clear();
+    std::string name, type;
+    std::size_t width;
+    while (in >> name >> type >> width)
+    {
+        StoreType t;
+        if (type == "i64")
+            t = STORE_INT64;
+        else if (type == "f64")
+            t = STORE_FLOAT64;
+        else if (type == "texto")
+            t = STORE_TEXT;
+        else
+            return false;
+        cols.push_back(StoreColumn{name, t, width});
+    }
+    return in.eof() && !cols.empty();
+}
+
+// Escribe n bytes en fd desde la posición off; false si falla
+inline bool storeWriteAt(int fd, const void *p, std::size_t n, off_t off)
+{
+    const char *c = static_cast<const char *>(p);
+    while (n > 0)
+    {
+        ssize_t w = ::pwrite(fd, c, n, off);
+        if (w <= 0)
+            return false;
+        c += w;
+        n -= std::size_t(w);
+        off += w;
+    }
+    return true;
+}
+
+// Añade row al almacén dir (creándolo si no existe). Si hay un error devuelve false
+// y lo describe en error
+inline bool appendStoreRow(const std::string &dir, const StoreRow &row, std::string &error)
+{
+    if (::mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST)
+    {
+        error = dir + ": " + std::strerror(errno);
+        return false;
+    }
+    const std::string rowsFile = dir + "/filas";
+    int lock = ::open(rowsFile.c_str(), O_RDWR | O_CREAT, 0644);
+    if (lock < 0 || ::flock(lock, LOCK_EX) != 0)
+    {
+        error = rowsFile + ": " + std::strerror(errno);
+        if (lock >= 0)
+            ::close(lock);
+        return false;
+    }
+
+    bool ok = true;
+    std::uint64_t n = 0;
+    if (::pread(lock, &n, sizeof(n), 0) != ssize_t(sizeof(n)))
+        n = 0;
+    const std::vector<StoreColumn> &cols = row.columns();
+    std::vector<StoreColumn> existing;
+    if (n == 0 && !readStoreSchema(dir, existing))
+    {
+        // Almacén nuevo: el esquema es el de esta fila
+        std::ofstream(dir + "/esquema") << storeSchemaText(cols);
+    }
+    else if (!readStoreSchema(dir, existing) || existing != cols)
+    {
+        error = dir + ": el almacén tiene otro esquema (exportarlo y empezar uno nuevo)";
+        ok = false;
+    }
+
+    for (std::size_t c = 0; ok && c < cols.size(); ++c)
+    {
+        const std::string file = dir + "/" + cols[c].name + ".col";
+        int fd = ::open(file.c_str(), O_WRONLY | O_CREAT, 0644);
+        const off_t off = off_t(n * cols[c].width);
+        // Lo que haya pasada la fila n es de una escritura que no se confirmó
+        ok = fd >= 0 && ::ftruncate(fd, off) == 0 && storeWriteAt(fd, row.value(c), cols[c].width, off);
+        if (!ok)
+            error = file + ": " + std::strerror(errno);
+        if (fd >= 0)
+            ::close(fd);
+    }
+    if (ok)
+    {
+        const std::uint64_t next = n + 1;
+        ok = storeWriteAt(lock, &next, sizeof(next), 0);
+        if (!ok)
+            error = rowsFile + ": " + std::strerror(errno);
+    }
+    ::flock(lock, LOCK_UN);
+    ::close(lock);
+    return ok;
+}
+
+// ----------------------------------------------------
+// Almacén proyectado en memoria (solo lectura)
+// ----------------------------------------------------
+class ColumnStore
+{
+public:
+    ColumnStore() = default;
+    ~ColumnStore() { close(); }
+
+    ColumnStore(const ColumnStore &) = delete;
+    ColumnStore &operator=(const ColumnStore &) = delete;
+
+    // Proyecta las filas confirmadas de dir; si hay un error devuelve false y lo
+    // describe en error
+    bool open(const std::string &dir, std::string &error)
+    {
+        close();
+        const std::string rowsFile = dir + "/filas";
+        int lock = ::open(rowsFile.c_str(), O_RDONLY);
+        if (lock < 0)
+        {
+            error = rowsFile + ": " + std::strerror(errno);
+            return false;
+        }
+        ::flock(lock, LOCK_SH);
+        std::uint64_t n = 0;
+        bool ok = ::pread(lock, &n, sizeof(n), 0) == ssize_t(sizeof(n));
+        if (!ok)
+            error = rowsFile + ": no es un almacén de resultados";
+        else if (!(ok = readStoreSchema(dir, cols)))
+            error = dir + "/esquema: no es un almacén de resultados";
+        ::flock(lock, LOCK_UN);
+        ::close(lock);
+        if (!ok)
+            return false;
+
+        rowCount = std::size_t(n);
+        maps.assign(cols.size(), nullptr);
+        for (std::size_t c = 0; c < cols.size() && rowCount > 0; ++c)
+        {
+            const std::string file = dir + "/" + cols[c].name + ".col";
+            const std::size_t bytes = rowCount * cols[c].width;
+            int fd = ::open(file.c_str(), O_RDONLY);
+            struct stat st;
+            if (fd < 0 || fstat(fd, &st) != 0 || std::size_t(st.st_size) < bytes)
+            {
+                error = file + ": columna incompleta";
+                if (fd >= 0)
+                    ::close(fd);
+                close();
+                return false;
+            }
+            void *p = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (p == MAP_FAILED)
+            {
+                error = file + ": mmap: " + std::strerror(errno);
+                close();
+                return false;
+            }
+            maps[c] = static_cast<const unsigned char *>(p);
+        }
+        return true;
+    }
+
+    void close()
+    {
+        for (std::size_t c = 0; c < maps.size(); ++c)
+            if (maps[c])
+                munmap(const_cast<unsigned char *>(maps[c]), rowCount * cols[c].width);
+        maps.clear();
+        rowCount = 0;
+    }
+
+    std::size_t rows() const { return rowCount; }
+    const std::vector<StoreColumn> &columns() const { return cols; }
+
+    // Índice de la columna name (columns().size() si no existe)
+    std::size_t find(const std::string &name) const
+    {
+        std::size_t c = 0;
+        while (c < cols.size() && cols[c].name != name)
+            ++c;
+        return c;
+    }
+
+    // Array de rows() valores de la columna name; nullptr si no existe, no es de ese
+    // tipo (std::int64_t o double) o el almacén está vacío
+    template <class T>
+    const T *values(const std::string &name) const
+    {
+        static_assert(sizeof(T) == 8, "las columnas numéricas son de 8 bytes");
+        const std::size_t c = find(name);
+        if (c == cols.size() || cols[c].type == STORE_TEXT || cols[c].width != sizeof(T) || rowCount == 0)
+            return nullptr;
+        return reinterpret_cast<const T *>(maps[c]);
+    }
+
+    // Valor de texto de la fila i de la columna c
+    std::string text(std::size_t c, std::size_t i) const
+    {
+        const char *p = reinterpret_cast<const char *>(maps[c] + i * cols[c].width);
+        return std::string(p, strnlen(p, cols[c].width));
+    }
+
+    // Vuelca el almacén a CSV: cabecera con los nombres de columna y una línea por fila
+    void writeCsv(std::ostream &out) const
+    {
+        for (std::size_t c = 0; c < cols.size(); ++c)
+            out << (c ? "," : "") << cols[c].name;
+        out << "\n";
+        char num[32];
+        for (std::size_t i = 0; i < rowCount; ++i)
+        {
+            for (std::size_t c = 0; c < cols.size(); ++c)
+            {
+                if (c)
+                    out << ",";
+                const unsigned char *p = maps[c] + i * cols[c].width;
+                if (cols[c].type == STORE_TEXT)
+                {
+                    out << text(c, i);
+                    continue;
+                }
+                if (cols[c].type == STORE_INT64)
+                {
+                    std::int64_t v;
+                    std::memcpy(&v, p, sizeof(v));
+                    std::snprintf(num, sizeof(num), "%lld", (long long)v);
+                }
+                else
+                {
+                    double v;
+                    std::memcpy(&v, p, sizeof(v));
+                    std::snprintf(num, sizeof(num), "%.10g", v);
+                }
+                out << num;
+            }
+            out << "\n";
+        }
+    }
+
+private:
+    std::vector<StoreColumn> cols;
+    std::vector<const unsigned char *> maps;
+    std::size_t rowCount = 0;
+};
@@ -0,0 +1,88 @@
+/**
+ * @file resultados.cpp
+ * @brief Lectura del almacén de resultados por columnas (result_store.h): resumen del
+ *        esquema y número de ejecuciones, o exportación a CSV con una fila por ejecución.
+ * compilar: c++ resultados.cpp -O2 -std=c++17 -pthread -o resultados
+ * ejecutar: ./resultados [<almacén>] [-csv <fichero>|-]
+ * Sin almacén se lee resultados_<host> (o PARADISEO_RESULTS); con -csv - el CSV sale
+ * por la salida estándar.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "result_rows.h"
+#include "result_store.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    string dir = resultStoreDir();
+    string csvFile;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-csv") == 0 && i + 1 < argc)
+            csvFile = argv[++i];
+        else if (argv[i][0] != '-')
+            dir = argv[i];
+        else
+        {
+            cerr << "Uso: " << argv[0] << " [<almacén>] [-csv <fichero>|-]" << endl;
+            return 1;
+        }
+    }
+
+    ColumnStore store;
+    string error;
+    if (!store.open(dir, error))
+    {
+        cerr << "No se puede leer el almacén: " << error << endl;
+        return 1;
+    }
+
+    if (csvFile == "-")
+    {
+        store.writeCsv(cout);
+        return 0;
+    }
+    if (!csvFile.empty())
+    {
+        ofstream csv(csvFile);
+        store.writeCsv(csv);
+        if (!csv)
+        {
+            cerr << "No se puede escribir " << csvFile << endl;
+            return 1;
+        }
+        cout << store.rows() << " ejecuciones exportadas a " << csvFile << endl;
+        return 0;
+    }
+
+    // Resumen: columnas y ejecuciones de cada problema
+    cout << dir << ": " << store.rows() << " ejecuciones, " << store.columns().size() << " columnas" << endl;
+    for (const StoreColumn &c : store.columns())
+        cout << "  " << c.name << " (" << storeTypeName(c.type) << ", " << c.width << " bytes)" << endl;
+    const size_t problemColumn = store.find("problema");
+    if (problemColumn < store.columns().size())
+    {
+        vector<pair<string, size_t>> counts;
+        for (size_t i = 0; i < store.rows(); ++i)
+        {
+            string p = store.text(problemColumn, i);
+            size_t k = 0;
+            while (k < counts.size() && counts[k].first != p)
+                ++k;
+            if (k == counts.size())
+                counts.push_back(make_pair(p, 0));
+            ++counts[k].second;
+        }
+        for (const auto &pc : counts)
+            cout << pc.first << ": " << pc.second << " ejecuciones" << endl;
+    }
+    return 0;
+}
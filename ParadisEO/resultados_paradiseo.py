@@ -0,0 +1,41 @@
+# Lectura del almacén de resultados por columnas (result_store.h) sin pasar por texto:
+# cada columna es un numpy.memmap sobre su fichero .col, de modo que cargar miles de
+# ejecuciones no copia ni analiza nada hasta que se usan los valores.
+#
+#   from resultados_paradiseo import cargar
+#   df = cargar()                      # resultados_<host> (o PARADISEO_RESULTS)
+#   df = cargar("resultados_nodo01")   # otro almacén
+#   df[df.problema == "sphere"].groupby("poblacion").tiempo.mean()
+import os
+import socket
+
+import numpy as np
+import pandas as pd
+
+TIPOS = {"i64": np.dtype("=i8"), "f64": np.dtype("=f8")}
+
+
+def directorio_por_defecto():
+    return os.environ.get("PARADISEO_RESULTS") or f"resultados_{socket.gethostname()}"
+
+
+def columnas(directorio=None):
+    """Diccionario nombre -> numpy.memmap con las filas confirmadas de cada columna."""
+    directorio = directorio or directorio_por_defecto()
+    n = int(np.fromfile(os.path.join(directorio, "filas"), dtype="=u8", count=1)[0])
+    cols = {}
+    with open(os.path.join(directorio, "esquema")) as f:
+        for linea in f:
+            nombre, tipo, ancho = linea.split()
+            dtype = TIPOS.get(tipo, np.dtype(f"S{ancho}"))
+            fichero = os.path.join(directorio, nombre + ".col")
+            cols[nombre] = np.memmap(fichero, dtype=dtype, mode="r", shape=(n,)) if n else np.empty(0, dtype)
+    return cols
+
+
+def cargar(directorio=None):
+    """DataFrame con una fila por ejecución; las columnas de texto pasan a str."""
+    cols = columnas(directorio)
+    df = pd.DataFrame({k: (v.astype(str) if v.dtype.kind == "S" else v) for k, v in cols.items()})
+    df["fecha_inicio"] = pd.to_datetime(df["fecha_inicio"], unit="s")
+    return df
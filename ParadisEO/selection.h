@@ -0,0 +1,131 @@
+/**
+ * @file selection.h
+ * @brief Selección por torneo y de élites sobre un vector contiguo de fitness.
+ *
+ * Devuelve índices en lugar de copias de individuos, de modo que cada padre o élite
+ * se copia una sola vez, directamente sobre la memoria reciclada del hijo.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Torneo determinista de tamaño tSize (maximización); en empate gana el primero sorteado
+template <class Rng>
+inline std::size_t detTournamentIndex(const double *fit, std::size_t n, unsigned tSize, Rng &gen)
+{
+    std::size_t best = gen.random(n);
+    for (unsigned t = 1; t < tSize; ++t)
+    {
+        std::size_t c = gen.random(n);
+        if (fit[c] > fit[best])
+            best = c;
+    }
+    return best;
+}
+
+// Deja en order[0, k) los índices de los k mejores (maximización), de mayor a menor
+// fitness y, en empate, el índice menor primero. nth_element separa los k mejores y
+// solo se ordenan esos: O(n + k log k) en lugar de ordenar toda la población
+inline void topKIndices(const double *fit, std::size_t n, std::size_t k, std::vector<std::size_t> &order)
+{
+    order.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+        order[i] = i;
+    k = std::min(k, n);
+    auto better = [fit](std::size_t a, std::size_t b)
+    {
+        return fit[a] > fit[b] || (fit[a] == fit[b] && a < b);
+    };
+    if (k < n)
+        std::nth_element(order.begin(), order.begin() + k, order.end(), better);
+    std::sort(order.begin(), order.begin() + k, better);
+}
+
+// Igual que topKIndices, pero con los k peores, de menor a mayor fitness
+inline void bottomKIndices(const double *fit, std::size_t n, std::size_t k, std::vector<std::size_t> &order)
+{
+    order.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+        order[i] = i;
+    k = std::min(k, n);
+    auto worse = [fit](std::size_t a, std::size_t b)
+    {
+        return fit[a] < fit[b] || (fit[a] == fit[b] && a < b);
+    };
+    if (k < n)
+        std::nth_element(order.begin(), order.begin() + k, order.end(), worse);
+    std::sort(order.begin(), order.begin() + k, worse);
+}
+
+// Montículo de mínimos indexado sobre un array de fitness: el peor individuo en O(1) y,
+// cuando cambia el fitness de uno, se recoloca en O(log n). Lo usa el reemplazo del
+// peor del modo estacionario (ga_engine.h)
+class WorstIndexHeap
+{
+public:
+    // Montículo de los n primeros individuos de fit, en O(n)
+    void build(const double *f, std::size_t n)
+    {
+        fit = f;
+        heap.resize(n);
+        pos.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+            place(i, i);
+        for (std::size_t p = n / 2; p-- > 0;)
+            siftDown(p);
+    }
+
+    std::size_t worst() const { return heap[0]; }
+
+    // Recoloca el individuo i tras cambiar su fitness
+    void update(std::size_t i)
+    {
+        siftUp(pos[i]);
+        siftDown(pos[i]);
+    }
+
+private:
+    void place(std::size_t p, std::size_t i)
+    {
+        heap[p] = i;
+        pos[i] = p;
+    }
+
+    void siftUp(std::size_t p)
+    {
+        std::size_t i = heap[p];
+        while (p > 0)
+        {
+            std::size_t parent = (p - 1) / 2;
+            if (!(fit[i] < fit[heap[parent]]))
+                break;
+            place(p, heap[parent]);
+            p = parent;
+        }
+        place(p, i);
+    }
+
+    void siftDown(std::size_t p)
+    {
+        const std::size_t n = heap.size();
+        std::size_t i = heap[p];
+        while (true)
+        {
+            std::size_t c = 2 * p + 1;
+            if (c >= n)
+                break;
+            if (c + 1 < n && fit[heap[c + 1]] < fit[heap[c]])
+                ++c;
+            if (!(fit[heap[c]] < fit[i]))
+                break;
+            place(p, heap[c]);
+            p = c;
+        }
+        place(p, i);
+    }
+
+    const double *fit = nullptr;
+    std::vector<std::size_t> heap, pos;
+};
@@ -0,0 +1,335 @@
+/**
+ * @file shm_islands.h
+ * @brief Modelo de islas repartido en procesos del mismo binario: cada proceso es una
+ *        isla y los emigrantes viajan por colas circulares de casillas de tamaño fijo
+ *        en un segmento de memoria compartida POSIX (shm_open + mmap).
+ *
+ * Es el mismo esquema que islands.h (mismas topologías, mismo reparto de la población
+ * y de las semillas, mismos emigrantes y sustitución de los peores), pero cada isla es
+ * un proceso aparte: su energía, su afinidad (taskset, numactl) y sus fallos quedan
+ * aislados, y cada isla puede usar a su vez varios hilos. No hay sockets ni MPI: todo
+ * el intercambio pasa por el segmento /<nombre>, cuya disposición es
+ *
+ *   ShmIslandHeader | K resultados | índices de las colas | casillas de las colas
+ *
+ * Cada cola (origen, destino) es SPSC, con cabeza y cola atómicas en su propia línea
+ * de caché; una casilla guarda fitness, raw_value y la fila del genoma tal cual está en
+ * la población, así que solo pueden compartir segmento procesos con el mismo problema
+ * y la misma dimensión (se comprueba al abrirlo). Los atómicos del segmento son libres
+ * de bloqueo y por tanto válidos entre procesos.
+ *
+ * El primer proceso que abre el segmento lo dimensiona e inicializa; los demás esperan
+ * a que esté listo y comprueban que la configuración coincide. Al terminar, cada isla
+ * deja su GaResult en el segmento; si ha resuelto el problema levanta la marca de
+ * cancelación que ven todas las demás, y la última en terminar borra el nombre.
+ */
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ga_engine.h"
+#include "islands.h"
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<bool>::is_always_lock_free,
+              "las colas compartidas entre procesos necesitan atómicos libres de bloqueo");
+
+// Bytes de una casilla para las filas de pop: fitness, raw_value y la fila completa
+// (con su relleno), redondeado a línea de caché
+template <class Population>
+std::size_t shmSlotBytes(const Population &pop)
+{
+    std::size_t bytes = 2 * sizeof(double) + pop.rowStride() * sizeof(*pop.row(0));
+    return (bytes + 63) / 64 * 64;
+}
+
+// ----------------------------------------------------
+// Cola SPSC de individuos sobre memoria compartida
+// ----------------------------------------------------
+struct ShmQueueIndex
+{
+    alignas(64) std::atomic<std::uint64_t> head;
+    alignas(64) std::atomic<std::uint64_t> tail;
+};
+
+class ShmMigrantQueue
+{
+public:
+    ShmMigrantQueue(ShmQueueIndex *index, unsigned char *slots, std::size_t capacity, std::size_t slotBytes)
+        : index(index), slots(slots), cap(capacity), slotBytes(slotBytes) {}
+
+    // Productor: copia src[j] a la cola; false (y se descarta) si está llena
+    template <class Population>
+    bool push(const Population &src, std::size_t j)
+    {
+        std::uint64_t t = index->tail.load(std::memory_order_relaxed);
+        if (t - index->head.load(std::memory_order_acquire) == cap)
+            return false;
+        unsigned char *slot = slots + (t % cap) * slotBytes;
+        double fr[2] = {src.fitnessData()[j], src.rawData()[j]};
+        std::memcpy(slot, fr, sizeof(fr));
+        std::memcpy(slot + sizeof(fr), src.row(j), src.rowStride() * sizeof(*src.row(j)));
+        index->tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor: saca el emigrante más antiguo sobre dst[i]; false si está vacía
+    template <class Population>
+    bool pop(Population &dst, std::size_t i)
+    {
+        std::uint64_t h = index->head.load(std::memory_order_relaxed);
+        if (h == index->tail.load(std::memory_order_acquire))
+            return false;
+        const unsigned char *slot = slots + (h % cap) * slotBytes;
+        double fr[2];
+        std::memcpy(fr, slot, sizeof(fr));
+        dst.fitnessData()[i] = fr[0];
+        dst.rawData()[i] = fr[1];
+        std::memcpy(dst.row(i), slot + sizeof(fr), dst.rowStride() * sizeof(*dst.row(i)));
+        index->head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    ShmQueueIndex *index;
+    unsigned char *slots;
+    std::size_t cap, slotBytes;
+};
+
+// ----------------------------------------------------
+// Enlace de un proceso con el segmento de sus islas
+// ----------------------------------------------------
+class ShmIslandLink
+{
+public:
+    ShmIslandLink() = default;
+    ~ShmIslandLink() { close(); }
+
+    ShmIslandLink(const ShmIslandLink &) = delete;
+    ShmIslandLink &operator=(const ShmIslandLink &) = delete;
+
+    // Abre (o crea e inicializa) el segmento /name para las islas de icfg con casillas
+    // de slotBytes bytes. Con fresh se borra antes cualquier segmento anterior con ese
+    // nombre (el lanzador de una ejecución nueva). Si hay un error devuelve false y lo
+    // describe en error
+    bool open(const std::string &name, const IslandConfig &icfg, std::size_t slotBytes, bool fresh,
+              std::string &error)
+    {
+        close();
+        this->name = "/" + name;
+        this->icfg = icfg;
+        if (this->icfg.capacity == 0)
+            this->icfg.capacity = 4 * std::max<std::size_t>(1, icfg.migrants);
+        const std::size_t k = this->icfg.islands;
+        nQueues = (this->icfg.topology == TOPOLOGY_RANDOM) ? k * k : k;
+        resultsOffset = roundUp(sizeof(ShmIslandHeader));
+        indexOffset = resultsOffset + k * roundUp(sizeof(ShmIslandResult));
+        slotsOffset = indexOffset + nQueues * sizeof(ShmQueueIndex);
+        bytes = slotsOffset + nQueues * this->icfg.capacity * slotBytes;
+
+        if (fresh)
+            shm_unlink(this->name.c_str());
+        int fd = shm_open(this->name.c_str(), O_RDWR | O_CREAT, 0600);
+        if (fd < 0)
+            return fail(error, "shm_open");
+        struct stat st;
+        bool ok = fstat(fd, &st) == 0;
+        // Un segmento recién creado mide 0 bytes (si dos procesos llegan a la vez los
+        // dos lo dimensionan igual); uno existente debe tener exactamente este tamaño
+        if (ok && st.st_size == 0)
+            ok = ftruncate(fd, off_t(bytes)) == 0;
+        else if (ok && std::size_t(st.st_size) != bytes)
+        {
+            ::close(fd);
+            error = this->name + ": el segmento existente no corresponde a esta configuración";
+            return false;
+        }
+        if (!ok)
+        {
+            ::close(fd);
+            return fail(error, "ftruncate");
+        }
+        void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED)
+            return fail(error, "mmap");
+        base = static_cast<unsigned char *>(p);
+
+        if (!initialize(slotBytes, error))
+        {
+            close();
+            return false;
+        }
+        queues.clear();
+        for (std::size_t q = 0; q < nQueues; ++q)
+            queues.emplace_back(reinterpret_cast<ShmQueueIndex *>(base + indexOffset) + q,
+                                base + slotsOffset + q * this->icfg.capacity * slotBytes,
+                                this->icfg.capacity, slotBytes);
+        return true;
+    }
+
+    void close()
+    {
+        if (base)
+            munmap(base, bytes);
+        base = nullptr;
+        queues.clear();
+    }
+
+    // Borra el nombre del segmento (las proyecciones abiertas siguen siendo válidas)
+    void unlink() const { shm_unlink(name.c_str()); }
+
+    const IslandConfig &config() const { return icfg; }
+
+    // Marca de cancelación común a todas las islas (GaConfig::cancel)
+    const std::atomic<bool> *cancelFlag() const { return &header()->cancelled; }
+
+    // Una migración de la isla i al empezar la generación gen (islands.h)
+    template <class Population>
+    void migrate(Population &pop, std::size_t i, std::size_t gen, std::uint64_t key, std::vector<std::size_t> &order)
+    {
+        migrateIsland(pop, i, gen, icfg, key, order,
+                      [this](std::size_t src, std::size_t dst) { return queue(src, dst); });
+    }
+
+    // Deja el resultado de la isla i; si lo ha resuelto para a las demás y, si es la
+    // última en terminar, borra el nombre del segmento
+    void finish(std::size_t i, const GaResult &r)
+    {
+        ShmIslandResult &slot = result(i);
+        slot.result = r;
+        slot.done.store(1, std::memory_order_release);
+        if (r.stop == STOP_SOLVED)
+            header()->cancelled.store(true, std::memory_order_relaxed);
+        if (header()->finished.fetch_add(1, std::memory_order_acq_rel) + 1 == icfg.islands)
+            unlink();
+    }
+
+    // Resultados de las islas que han terminado (las que fallaron no aparecen)
+    std::vector<GaResult> results() const
+    {
+        std::vector<GaResult> out;
+        for (std::size_t i = 0; i < icfg.islands; ++i)
+            if (result(i).done.load(std::memory_order_acquire))
+                out.push_back(result(i).result);
+        return out;
+    }
+
+    bool finished(std::size_t i) const { return result(i).done.load(std::memory_order_acquire) != 0; }
+
+private:
+    static constexpr std::uint32_t MAGIC = 0x50454953; // "PEIS"
+
+    enum
+    {
+        SEGMENT_EMPTY,
+        SEGMENT_INITIALIZING,
+        SEGMENT_READY
+    };
+
+    struct ShmIslandHeader
+    {
+        std::atomic<std::uint32_t> state;
+        std::uint32_t magic;
+        std::uint64_t islands, capacity, slotBytes, topology;
+        std::atomic<bool> cancelled;
+        std::atomic<std::uint64_t> finished;
+    };
+
+    struct alignas(64) ShmIslandResult
+    {
+        std::atomic<std::uint32_t> done;
+        GaResult result;
+    };
+
+    static std::size_t roundUp(std::size_t b) { return (b + 63) / 64 * 64; }
+
+    bool fail(std::string &error, const char *call)
+    {
+        error = name + ": " + call + ": " + std::strerror(errno);
+        return false;
+    }
+
+    ShmIslandHeader *header() const { return reinterpret_cast<ShmIslandHeader *>(base); }
+
+    ShmIslandResult &result(std::size_t i) const
+    {
+        return *reinterpret_cast<ShmIslandResult *>(base + resultsOffset + i * roundUp(sizeof(ShmIslandResult)));
+    }
+
+    ShmMigrantQueue *queue(std::size_t src, std::size_t dst)
+    {
+        const std::size_t k = icfg.islands;
+        if (icfg.topology == TOPOLOGY_RANDOM)
+            return &queues[src * k + dst];
+        return dst == (src + 1) % k ? &queues[src] : nullptr;
+    }
+
+    // El segmento recién creado está a cero: el primero que pasa de EMPTY a
+    // INITIALIZING construye los atómicos y los resultados; los demás esperan a READY
+    bool initialize(std::size_t slotBytes, std::string &error)
+    {
+        // Antes de construirlo, el estado es una palabra a cero en memoria compartida
+        auto *state = reinterpret_cast<std::atomic<std::uint32_t> *>(base);
+        std::uint32_t expected = SEGMENT_EMPTY;
+        if (state->compare_exchange_strong(expected, SEGMENT_INITIALIZING, std::memory_order_acq_rel))
+        {
+            ShmIslandHeader *h = header();
+            h->magic = MAGIC;
+            h->islands = icfg.islands;
+            h->capacity = icfg.capacity;
+            h->slotBytes = slotBytes;
+            h->topology = icfg.topology;
+            new (&h->cancelled) std::atomic<bool>(false);
+            new (&h->finished) std::atomic<std::uint64_t>(0);
+            for (std::size_t i = 0; i < icfg.islands; ++i)
+                new (&result(i)) ShmIslandResult();
+            for (std::size_t q = 0; q < nQueues; ++q)
+            {
+                ShmQueueIndex *idx = reinterpret_cast<ShmQueueIndex *>(base + indexOffset) + q;
+                new (&idx->head) std::atomic<std::uint64_t>(0);
+                new (&idx->tail) std::atomic<std::uint64_t>(0);
+            }
+            state->store(SEGMENT_READY, std::memory_order_release);
+        }
+        else
+        {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (state->load(std::memory_order_acquire) != SEGMENT_READY)
+            {
+                if (std::chrono::steady_clock::now() > deadline)
+                {
+                    error = name + ": el segmento no termina de inicializarse";
+                    return false;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        const ShmIslandHeader *h = header();
+        if (h->magic != MAGIC || h->islands != icfg.islands || h->capacity != icfg.capacity ||
+            h->slotBytes != slotBytes || h->topology != std::uint64_t(icfg.topology))
+        {
+            error = name + ": el segmento existente no corresponde a esta configuración";
+            return false;
+        }
+        return true;
+    }
+
+    std::string name;
+    IslandConfig icfg;
+    unsigned char *base = nullptr;
+    std::size_t bytes = 0, nQueues = 0, resultsOffset = 0, indexOffset = 0, slotsOffset = 0;
+    std::vector<ShmMigrantQueue> queues;
+};
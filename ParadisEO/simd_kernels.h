@@ -0,0 +1,618 @@
+/**
+ * @file simd_kernels.h
+ * @brief Núcleos vectorizados (SSE2 / AVX2+FMA / AVX-512) de las funciones objetivo reales,
+ *        elegidos una vez al arrancar según la CPU (ver simdLevel() en cpu_features.h).
+ *
+ * La ruta escalar reproduce exactamente la aritmética del código original y es la
+ * referencia. En Sphere y Rosenbrock las rutas SIMD solo cambian el orden de la suma
+ * (varios acumuladores parciales) y contraen multiplicación+suma en FMA. Tolerancias documentadas, con
+ * u = 2^-53 y n la dimensión:
+ *  - Sphere: todos los términos son no negativos, así que basta la cota de la suma
+ *    recursiva, |S' - S| <= 2 (n + 2) u S (< 2.3e-13 relativo para n = 1024).
+ *  - Rosenbrock: x[i+1] - x[i]^2 sufre cancelación (también en la referencia), así
+ *    que la cota se expresa sobre la suma de magnitudes
+ *    M = sum 100 (|x[i+1]| + x[i]^2)^2 + (|x[i]| + 1)^2:  |S' - S| <= 4 (n + 2) u M.
+ *    Medido sobre vectores aleatorios del dominio y cerca del óptimo: como mucho
+ *    1.5 (n + 2) u M y < 5e-15 relativo (menos de 40 ULP) con n = 1024.
+ *  - Schwefel: las rutas SIMD sustituyen el sin() de libm por una aproximación propia
+ *    de sin(sqrt|x|) válida en el dominio [-500, 500] (ver SIN_TAYLOR más abajo). La raíz
+ *    es la instrucción sqrtpd, con redondeo correcto igual que std::sqrt. Cada término
+ *    x sin(sqrt|x|) difiere de la referencia en menos de 8 u |x|, y la suma cumple
+ *    |S' - S| <= (n + 10) u A, con A = 418.9829 n + sum |x_i|.
+ *    Medido: 4.4 u |x| por término y 0.18 (n + 10) u A en la suma (< 2e-9 absoluto
+ *    con n = 1024, frente a S del orden de 1e5; domina el orden de la suma, igual que
+ *    el propio redondeo de la referencia). Sobre poblaciones uniformes, cercanas al
+ *    óptimo y con genes en los extremos, la ordenación coincide con la ruta escalar
+ *    en todos los pares cuyos valores de referencia se separan más que la cota.
+ *
+ * test_simd_kernels.cpp comprueba estas cotas, la igualdad exacta de las versiones por
+ * lotes y la ordenación sobre un corpus de semilla fija, en cada nivel que permite
+ * simdLevel(). Compilar y ejecutar según su cabecera; termina con código 1 si algo falla.
+ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "cpu_features.h"
+
+// ----------------------------------------------------
+// Referencia escalar (misma aritmética que la versión original)
+// ----------------------------------------------------
+inline double sumSquaresScalar(const double *x, std::size_t n)
+{
+    double raw = 0.0;
+    for (std::size_t i = 0; i < n; ++i)
+        raw += x[i] * x[i];
+    return raw;
+}
+
+inline double rosenbrockScalar(const double *x, std::size_t n)
+{
+    double raw = 0.0;
+    for (std::size_t i = 0; i + 1 < n; ++i)
+        raw += 100.0 * std::pow(x[i + 1] - std::pow(x[i], 2), 2) + std::pow(x[i] - 1.0, 2);
+    return raw;
+}
+
+// Constante de Schwefel por dimensión: f(x) = 418.9829 n - sum x_i sin(sqrt|x_i|)
+static constexpr double SCHWEFEL_ALPHA = 418.9829;
+
+inline double schwefelScalar(const double *x, std::size_t n)
+{
+    double raw = SCHWEFEL_ALPHA * static_cast<double>(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        // Evitar problemas con raíz cuadrada de cero
+        if (std::abs(x[i]) >= 1e-10)
+            raw -= x[i] * std::sin(std::sqrt(std::abs(x[i])));
+    }
+    return raw;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// ----------------------------------------------------
+// sin(t) vectorizado para t = sqrt|x| en [0, sqrt(500)] ~ [0, 22.37]
+// Reducción de Cody-Waite: k = round(t / pi), r = t - k pi en [-pi/2, pi/2] con pi
+// partido en tres trozos (k pi_1 es exacto para k < 2^7) y sin(t) = (-1)^k sin(r).
+// sin(r) es el desarrollo de Taylor hasta grado 19: el resto es menor que
+// (pi/2)^21 / 21! < 2.6e-16, y el error de la reducción y de Horner suma unas pocas
+// u más. k se obtiene con el truco de la constante 1.5 * 2^52: el bit bajo de la
+// mantisa es la paridad de k, que se lleva al bit de signo sin pasar a enteros.
+// ----------------------------------------------------
+static constexpr double SIN_PI_1 = 3.14159250259399414062;
+static constexpr double SIN_PI_2 = 1.50995788317231927067e-7;
+static constexpr double SIN_PI_3 = 1.07806057163162381058e-14;
+static constexpr double SIN_INV_PI = 0.31830988618379067154;
+static constexpr double SIN_ROUND_MAGIC = 6755399441055744.0; // 1.5 * 2^52
+// Coeficientes 1/3!, 1/5!, ..., 1/19! con signo alterno (de grado mayor a menor)
+static constexpr double SIN_TAYLOR[9] = {
+    -1.0 / 121645100408832000.0, 1.0 / 355687428096000.0, -1.0 / 1307674368000.0,
+    1.0 / 6227020800.0, -1.0 / 39916800.0, 1.0 / 362880.0,
+    -1.0 / 5040.0, 1.0 / 120.0, -1.0 / 6.0};
+
+// ----------------------------------------------------
+// SSE2: 2 dobles por registro, dos acumuladores
+// ----------------------------------------------------
+__attribute__((target("sse2"))) inline double sumSquaresSse2(const double *x, std::size_t n)
+{
+    __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128d v0 = _mm_loadu_pd(x + i), v1 = _mm_loadu_pd(x + i + 2);
+        a0 = _mm_add_pd(a0, _mm_mul_pd(v0, v0));
+        a1 = _mm_add_pd(a1, _mm_mul_pd(v1, v1));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(a0, a1));
+    double raw = lanes[0] + lanes[1];
+    for (; i < n; ++i)
+        raw += x[i] * x[i];
+    return raw;
+}
+
+__attribute__((target("sse2"))) inline double rosenbrockSse2(const double *x, std::size_t n)
+{
+    const __m128d hundred = _mm_set1_pd(100.0), one = _mm_set1_pd(1.0);
+    __m128d acc = _mm_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 2 < n; i += 2)
+    {
+        __m128d a = _mm_loadu_pd(x + i), b = _mm_loadu_pd(x + i + 1);
+        __m128d t = _mm_sub_pd(b, _mm_mul_pd(a, a));
+        __m128d u = _mm_sub_pd(a, one);
+        acc = _mm_add_pd(acc, _mm_add_pd(_mm_mul_pd(hundred, _mm_mul_pd(t, t)), _mm_mul_pd(u, u)));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, acc);
+    double raw = lanes[0] + lanes[1];
+    for (; i + 1 < n; ++i)
+    {
+        double t = x[i + 1] - x[i] * x[i], u = x[i] - 1.0;
+        raw += 100.0 * t * t + u * u;
+    }
+    return raw;
+}
+
+// x sin(sqrt|x|) para dos genes; sin ramas, x = 0 da 0 de forma natural
+__attribute__((target("sse2"))) inline __m128d schwefelTermSse2(__m128d x)
+{
+    const __m128d signMask = _mm_set1_pd(-0.0), magic = _mm_set1_pd(SIN_ROUND_MAGIC);
+    __m128d t = _mm_sqrt_pd(_mm_andnot_pd(signMask, x));
+    __m128d kd = _mm_add_pd(_mm_mul_pd(t, _mm_set1_pd(SIN_INV_PI)), magic);
+    __m128d odd = _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(kd), 63));
+    __m128d k = _mm_sub_pd(kd, magic);
+    __m128d r = _mm_sub_pd(t, _mm_mul_pd(k, _mm_set1_pd(SIN_PI_1)));
+    r = _mm_sub_pd(r, _mm_mul_pd(k, _mm_set1_pd(SIN_PI_2)));
+    r = _mm_sub_pd(r, _mm_mul_pd(k, _mm_set1_pd(SIN_PI_3)));
+    __m128d r2 = _mm_mul_pd(r, r);
+    __m128d p = _mm_set1_pd(SIN_TAYLOR[0]);
+    for (int j = 1; j < 9; ++j)
+        p = _mm_add_pd(_mm_mul_pd(p, r2), _mm_set1_pd(SIN_TAYLOR[j]));
+    __m128d sn = _mm_add_pd(r, _mm_mul_pd(_mm_mul_pd(r, r2), p));
+    return _mm_mul_pd(x, _mm_xor_pd(sn, odd));
+}
+
+__attribute__((target("sse2"))) inline double schwefelSse2(const double *x, std::size_t n)
+{
+    __m128d a0 = _mm_setzero_pd(), a1 = _mm_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        a0 = _mm_add_pd(a0, schwefelTermSse2(_mm_loadu_pd(x + i)));
+        a1 = _mm_add_pd(a1, schwefelTermSse2(_mm_loadu_pd(x + i + 2)));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(a0, a1));
+    double sum = lanes[0] + lanes[1];
+    for (; i < n; ++i)
+        sum += x[i] * std::sin(std::sqrt(std::abs(x[i])));
+    return SCHWEFEL_ALPHA * static_cast<double>(n) - sum;
+}
+
+// ----------------------------------------------------
+// AVX2 + FMA: 4 dobles por registro, dos acumuladores
+// ----------------------------------------------------
+__attribute__((target("avx2,fma"))) inline double hsumAvx(__m256d v)
+{
+    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+__attribute__((target("avx2,fma"))) inline double sumSquaresAvx2(const double *x, std::size_t n)
+{
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256d v0 = _mm256_loadu_pd(x + i), v1 = _mm256_loadu_pd(x + i + 4);
+        a0 = _mm256_fmadd_pd(v0, v0, a0);
+        a1 = _mm256_fmadd_pd(v1, v1, a1);
+    }
+    double raw = hsumAvx(_mm256_add_pd(a0, a1));
+    for (; i < n; ++i)
+        raw += x[i] * x[i];
+    return raw;
+}
+
+__attribute__((target("avx2,fma"))) inline double rosenbrockAvx2(const double *x, std::size_t n)
+{
+    const __m256d hundred = _mm256_set1_pd(100.0), one = _mm256_set1_pd(1.0);
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 < n; i += 4)
+    {
+        __m256d a = _mm256_loadu_pd(x + i), b = _mm256_loadu_pd(x + i + 1);
+        __m256d t = _mm256_fnmadd_pd(a, a, b); // b - a*a
+        __m256d u = _mm256_sub_pd(a, one);
+        a0 = _mm256_fmadd_pd(_mm256_mul_pd(hundred, t), t, a0);
+        a1 = _mm256_fmadd_pd(u, u, a1);
+    }
+    double raw = hsumAvx(_mm256_add_pd(a0, a1));
+    for (; i + 1 < n; ++i)
+    {
+        double t = x[i + 1] - x[i] * x[i], u = x[i] - 1.0;
+        raw += 100.0 * t * t + u * u;
+    }
+    return raw;
+}
+
+__attribute__((target("avx2,fma"))) inline __m256d schwefelTermAvx2(__m256d x)
+{
+    const __m256d signMask = _mm256_set1_pd(-0.0), magic = _mm256_set1_pd(SIN_ROUND_MAGIC);
+    __m256d t = _mm256_sqrt_pd(_mm256_andnot_pd(signMask, x));
+    __m256d kd = _mm256_fmadd_pd(t, _mm256_set1_pd(SIN_INV_PI), magic);
+    __m256d odd = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(kd), 63));
+    __m256d k = _mm256_sub_pd(kd, magic);
+    __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(SIN_PI_1), t);
+    r = _mm256_fnmadd_pd(k, _mm256_set1_pd(SIN_PI_2), r);
+    r = _mm256_fnmadd_pd(k, _mm256_set1_pd(SIN_PI_3), r);
+    __m256d r2 = _mm256_mul_pd(r, r);
+    __m256d p = _mm256_set1_pd(SIN_TAYLOR[0]);
+    for (int j = 1; j < 9; ++j)
+        p = _mm256_fmadd_pd(p, r2, _mm256_set1_pd(SIN_TAYLOR[j]));
+    __m256d sn = _mm256_fmadd_pd(_mm256_mul_pd(r, r2), p, r);
+    return _mm256_mul_pd(x, _mm256_xor_pd(sn, odd));
+}
+
+__attribute__((target("avx2,fma"))) inline double schwefelAvx2(const double *x, std::size_t n)
+{
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        a0 = _mm256_add_pd(a0, schwefelTermAvx2(_mm256_loadu_pd(x + i)));
+        a1 = _mm256_add_pd(a1, schwefelTermAvx2(_mm256_loadu_pd(x + i + 4)));
+    }
+    double sum = hsumAvx(_mm256_add_pd(a0, a1));
+    for (; i < n; ++i)
+        sum += x[i] * std::sin(std::sqrt(std::abs(x[i])));
+    return SCHWEFEL_ALPHA * static_cast<double>(n) - sum;
+}
+
+// ----------------------------------------------------
+// AVX-512: 8 dobles por registro, dos acumuladores
+// ----------------------------------------------------
+__attribute__((target("avx512f"))) inline double hsumAvx512(__m512d v)
+{
+    alignas(64) double lanes[8];
+    _mm512_store_pd(lanes, v);
+    return ((lanes[0] + lanes[4]) + (lanes[1] + lanes[5])) + ((lanes[2] + lanes[6]) + (lanes[3] + lanes[7]));
+}
+
+__attribute__((target("avx512f"))) inline double sumSquaresAvx512(const double *x, std::size_t n)
+{
+    __m512d a0 = _mm512_setzero_pd(), a1 = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m512d v0 = _mm512_loadu_pd(x + i), v1 = _mm512_loadu_pd(x + i + 8);
+        a0 = _mm512_fmadd_pd(v0, v0, a0);
+        a1 = _mm512_fmadd_pd(v1, v1, a1);
+    }
+    if (i + 8 <= n)
+    {
+        __m512d v = _mm512_loadu_pd(x + i);
+        a0 = _mm512_fmadd_pd(v, v, a0);
+        i += 8;
+    }
+    if (i < n)
+    {
+        // Cola enmascarada: los carriles fuera de rango se cargan como 0
+        __mmask8 tail = __mmask8((1u << (n - i)) - 1u);
+        __m512d v = _mm512_maskz_loadu_pd(tail, x + i);
+        a1 = _mm512_fmadd_pd(v, v, a1);
+    }
+    return hsumAvx512(_mm512_add_pd(a0, a1));
+}
+
+__attribute__((target("avx512f"))) inline double rosenbrockAvx512(const double *x, std::size_t n)
+{
+    const __m512d hundred = _mm512_set1_pd(100.0), one = _mm512_set1_pd(1.0);
+    __m512d a0 = _mm512_setzero_pd(), a1 = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 8 < n; i += 8)
+    {
+        __m512d a = _mm512_loadu_pd(x + i), b = _mm512_loadu_pd(x + i + 1);
+        __m512d t = _mm512_fnmadd_pd(a, a, b); // b - a*a
+        __m512d u = _mm512_sub_pd(a, one);
+        a0 = _mm512_fmadd_pd(_mm512_mul_pd(hundred, t), t, a0);
+        a1 = _mm512_fmadd_pd(u, u, a1);
+    }
+    double raw = hsumAvx512(_mm512_add_pd(a0, a1));
+    for (; i + 1 < n; ++i)
+    {
+        double t = x[i + 1] - x[i] * x[i], u = x[i] - 1.0;
+        raw += 100.0 * t * t + u * u;
+    }
+    return raw;
+}
+
+__attribute__((target("avx512f"))) inline __m512d schwefelTermAvx512(__m512d x)
+{
+    const __m512d magic = _mm512_set1_pd(SIN_ROUND_MAGIC);
+    __m512d t = _mm512_maskz_sqrt_pd(0xFF, _mm512_abs_pd(x));
+    __m512d kd = _mm512_fmadd_pd(t, _mm512_set1_pd(SIN_INV_PI), magic);
+    __m512i odd = _mm512_maskz_slli_epi64(0xFF, _mm512_castpd_si512(kd), 63);
+    __m512d k = _mm512_sub_pd(kd, magic);
+    __m512d r = _mm512_fnmadd_pd(k, _mm512_set1_pd(SIN_PI_1), t);
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(SIN_PI_2), r);
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(SIN_PI_3), r);
+    __m512d r2 = _mm512_mul_pd(r, r);
+    __m512d p = _mm512_set1_pd(SIN_TAYLOR[0]);
+    for (int j = 1; j < 9; ++j)
+        p = _mm512_fmadd_pd(p, r2, _mm512_set1_pd(SIN_TAYLOR[j]));
+    __m512d sn = _mm512_fmadd_pd(_mm512_mul_pd(r, r2), p, r);
+    sn = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(sn), odd));
+    return _mm512_mul_pd(x, sn);
+}
+
+__attribute__((target("avx512f"))) inline double schwefelAvx512(const double *x, std::size_t n)
+{
+    __m512d a0 = _mm512_setzero_pd(), a1 = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        a0 = _mm512_add_pd(a0, schwefelTermAvx512(_mm512_loadu_pd(x + i)));
+        a1 = _mm512_add_pd(a1, schwefelTermAvx512(_mm512_loadu_pd(x + i + 8)));
+    }
+    if (i < n)
+    {
+        // Cola enmascarada: los carriles a 0 aportan 0 * sin(0) = 0
+        std::size_t m = n - i < 8 ? n - i : 8;
+        __m512d v = _mm512_maskz_loadu_pd(__mmask8((1u << m) - 1u), x + i);
+        a0 = _mm512_add_pd(a0, schwefelTermAvx512(v));
+        i += m;
+    }
+    if (i < n)
+    {
+        __m512d v = _mm512_maskz_loadu_pd(__mmask8((1u << (n - i)) - 1u), x + i);
+        a1 = _mm512_add_pd(a1, schwefelTermAvx512(v));
+    }
+    return SCHWEFEL_ALPHA * static_cast<double>(n) - hsumAvx512(_mm512_add_pd(a0, a1));
+}
+#endif
+
+// ----------------------------------------------------
+// Evaluación por lotes: count filas consecutivas separadas stride dobles
+// (el formato de RealPopulation), resultado en out[0..count). Cada fila obtiene
+// exactamente el mismo valor que con el núcleo individual, así que el camino por
+// lotes y el individual producen la misma ejecución del GA.
+// ----------------------------------------------------
+typedef void (*RowsKernel)(const double *rows, std::size_t stride, std::size_t dim,
+                           std::size_t count, double *out);
+
+// Lote genérico: el núcleo individual fila a fila (sin coste de despacho por fila)
+template <double (*Kernel)(const double *, std::size_t)>
+inline void rowsByRow(const double *rows, std::size_t stride, std::size_t dim,
+                      std::size_t count, double *out)
+{
+    for (std::size_t r = 0; r < count; ++r)
+        out[r] = Kernel(rows + r * stride, dim);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Bloques de 4 individuos (un carril por individuo en la reducción final): los
+// 4 recorridos por genes se entrelazan y las 4 sumas horizontales se hacen a la
+// vez, con el mismo orden de suma que hsumAvx / hsumAvx512. Los pasos de cada fila
+// van en funciones aparte para que los 8 acumuladores se queden en registros.
+__attribute__((target("avx2,fma"))) inline __m256d hsum4Avx(__m256d v0, __m256d v1, __m256d v2, __m256d v3)
+{
+    __m256d s01 = _mm256_add_pd(_mm256_permute2f128_pd(v0, v1, 0x20), _mm256_permute2f128_pd(v0, v1, 0x31));
+    __m256d s23 = _mm256_add_pd(_mm256_permute2f128_pd(v2, v3, 0x20), _mm256_permute2f128_pd(v2, v3, 0x31));
+    // hadd deja {r0, r2, r1, r3}
+    return _mm256_permute4x64_pd(_mm256_hadd_pd(s01, s23), 0xD8);
+}
+
+__attribute__((target("avx2,fma"))) inline void sumSquaresStepAvx2(const double *x, __m256d &a0, __m256d &a1)
+{
+    __m256d v0 = _mm256_loadu_pd(x), v1 = _mm256_loadu_pd(x + 4);
+    a0 = _mm256_fmadd_pd(v0, v0, a0);
+    a1 = _mm256_fmadd_pd(v1, v1, a1);
+}
+
+__attribute__((target("avx2,fma"))) inline void rosenbrockStepAvx2(const double *x, __m256d &a0, __m256d &a1)
+{
+    const __m256d hundred = _mm256_set1_pd(100.0), one = _mm256_set1_pd(1.0);
+    __m256d a = _mm256_loadu_pd(x), b = _mm256_loadu_pd(x + 1);
+    __m256d t = _mm256_fnmadd_pd(a, a, b); // b - a*a
+    __m256d u = _mm256_sub_pd(a, one);
+    a0 = _mm256_fmadd_pd(_mm256_mul_pd(hundred, t), t, a0);
+    a1 = _mm256_fmadd_pd(u, u, a1);
+}
+
+// Colas escalares de las 4 filas de un bloque, en el mismo orden que el núcleo individual
+inline void sumSquaresTail4(const double *x, std::size_t stride, std::size_t from, std::size_t dim, double *out)
+{
+    for (std::size_t j = 0; j < 4; ++j, x += stride)
+        for (std::size_t t = from; t < dim; ++t)
+            out[j] += x[t] * x[t];
+}
+
+inline void rosenbrockTail4(const double *x, std::size_t stride, std::size_t from, std::size_t dim, double *out)
+{
+    for (std::size_t j = 0; j < 4; ++j, x += stride)
+        for (std::size_t t = from; t + 1 < dim; ++t)
+        {
+            double d = x[t + 1] - x[t] * x[t], e = x[t] - 1.0;
+            out[j] += 100.0 * d * d + e * e;
+        }
+}
+
+__attribute__((target("avx2,fma"))) inline void sumSquaresRowsAvx2(const double *rows, std::size_t stride, std::size_t dim,
+                                                                   std::size_t count, double *out)
+{
+    std::size_t r = 0;
+    for (; r + 4 <= count; r += 4)
+    {
+        const double *x0 = rows + r * stride, *x1 = x0 + stride, *x2 = x1 + stride, *x3 = x2 + stride;
+        __m256d a00 = _mm256_setzero_pd(), a01 = a00, a10 = a00, a11 = a00, a20 = a00, a21 = a00, a30 = a00, a31 = a00;
+        std::size_t i = 0;
+        for (; i + 8 <= dim; i += 8)
+        {
+            sumSquaresStepAvx2(x0 + i, a00, a01);
+            sumSquaresStepAvx2(x1 + i, a10, a11);
+            sumSquaresStepAvx2(x2 + i, a20, a21);
+            sumSquaresStepAvx2(x3 + i, a30, a31);
+        }
+        _mm256_storeu_pd(out + r, hsum4Avx(_mm256_add_pd(a00, a01), _mm256_add_pd(a10, a11),
+                                           _mm256_add_pd(a20, a21), _mm256_add_pd(a30, a31)));
+        sumSquaresTail4(x0, stride, i, dim, out + r);
+    }
+    for (; r < count; ++r)
+        out[r] = sumSquaresAvx2(rows + r * stride, dim);
+}
+
+__attribute__((target("avx2,fma"))) inline void rosenbrockRowsAvx2(const double *rows, std::size_t stride, std::size_t dim,
+                                                                   std::size_t count, double *out)
+{
+    std::size_t r = 0;
+    for (; r + 4 <= count; r += 4)
+    {
+        const double *x0 = rows + r * stride, *x1 = x0 + stride, *x2 = x1 + stride, *x3 = x2 + stride;
+        __m256d a00 = _mm256_setzero_pd(), a01 = a00, a10 = a00, a11 = a00, a20 = a00, a21 = a00, a30 = a00, a31 = a00;
+        std::size_t i = 0;
+        for (; i + 4 < dim; i += 4)
+        {
+            rosenbrockStepAvx2(x0 + i, a00, a01);
+            rosenbrockStepAvx2(x1 + i, a10, a11);
+            rosenbrockStepAvx2(x2 + i, a20, a21);
+            rosenbrockStepAvx2(x3 + i, a30, a31);
+        }
+        _mm256_storeu_pd(out + r, hsum4Avx(_mm256_add_pd(a00, a01), _mm256_add_pd(a10, a11),
+                                           _mm256_add_pd(a20, a21), _mm256_add_pd(a30, a31)));
+        rosenbrockTail4(x0, stride, i, dim, out + r);
+    }
+    for (; r < count; ++r)
+        out[r] = rosenbrockAvx2(rows + r * stride, dim);
+}
+
+__attribute__((target("avx512f"))) inline __m256d hsum4Avx512(__m512d v0, __m512d v1, __m512d v2, __m512d v3)
+{
+    // Se pasa por memoria, como en hsumAvx512, para partir cada registro en dos mitades
+    alignas(64) double l[4][8];
+    _mm512_store_pd(l[0], v0);
+    _mm512_store_pd(l[1], v1);
+    _mm512_store_pd(l[2], v2);
+    _mm512_store_pd(l[3], v3);
+    __m256d s0 = _mm256_add_pd(_mm256_load_pd(l[0]), _mm256_load_pd(l[0] + 4));
+    __m256d s1 = _mm256_add_pd(_mm256_load_pd(l[1]), _mm256_load_pd(l[1] + 4));
+    __m256d s2 = _mm256_add_pd(_mm256_load_pd(l[2]), _mm256_load_pd(l[2] + 4));
+    __m256d s3 = _mm256_add_pd(_mm256_load_pd(l[3]), _mm256_load_pd(l[3] + 4));
+    __m256d p = _mm256_hadd_pd(s0, s1), q = _mm256_hadd_pd(s2, s3);
+    return _mm256_add_pd(_mm256_permute2f128_pd(p, q, 0x20), _mm256_permute2f128_pd(p, q, 0x31));
+}
+
+__attribute__((target("avx512f"))) inline void sumSquaresStepAvx512(const double *x, __m512d &a0, __m512d &a1)
+{
+    __m512d v0 = _mm512_loadu_pd(x), v1 = _mm512_loadu_pd(x + 8);
+    a0 = _mm512_fmadd_pd(v0, v0, a0);
+    a1 = _mm512_fmadd_pd(v1, v1, a1);
+}
+
+// Restos de sumSquaresAvx512 (8 genes sueltos y cola enmascarada) para una fila
+__attribute__((target("avx512f"))) inline void sumSquaresRestAvx512(const double *x, std::size_t i, std::size_t dim,
+                                                                    __m512d &a0, __m512d &a1)
+{
+    if (i + 8 <= dim)
+    {
+        __m512d v = _mm512_loadu_pd(x + i);
+        a0 = _mm512_fmadd_pd(v, v, a0);
+        i += 8;
+    }
+    if (i < dim)
+    {
+        __m512d v = _mm512_maskz_loadu_pd(__mmask8((1u << (dim - i)) - 1u), x + i);
+        a1 = _mm512_fmadd_pd(v, v, a1);
+    }
+}
+
+__attribute__((target("avx512f"))) inline void rosenbrockStepAvx512(const double *x, __m512d &a0, __m512d &a1)
+{
+    const __m512d hundred = _mm512_set1_pd(100.0), one = _mm512_set1_pd(1.0);
+    __m512d a = _mm512_loadu_pd(x), b = _mm512_loadu_pd(x + 1);
+    __m512d t = _mm512_fnmadd_pd(a, a, b); // b - a*a
+    __m512d u = _mm512_sub_pd(a, one);
+    a0 = _mm512_fmadd_pd(_mm512_mul_pd(hundred, t), t, a0);
+    a1 = _mm512_fmadd_pd(u, u, a1);
+}
+
+__attribute__((target("avx512f"))) inline void sumSquaresRowsAvx512(const double *rows, std::size_t stride, std::size_t dim,
+                                                                    std::size_t count, double *out)
+{
+    std::size_t r = 0;
+    for (; r + 4 <= count; r += 4)
+    {
+        const double *x0 = rows + r * stride, *x1 = x0 + stride, *x2 = x1 + stride, *x3 = x2 + stride;
+        __m512d a00 = _mm512_setzero_pd(), a01 = a00, a10 = a00, a11 = a00, a20 = a00, a21 = a00, a30 = a00, a31 = a00;
+        std::size_t i = 0;
+        for (; i + 16 <= dim; i += 16)
+        {
+            sumSquaresStepAvx512(x0 + i, a00, a01);
+            sumSquaresStepAvx512(x1 + i, a10, a11);
+            sumSquaresStepAvx512(x2 + i, a20, a21);
+            sumSquaresStepAvx512(x3 + i, a30, a31);
+        }
+        sumSquaresRestAvx512(x0, i, dim, a00, a01);
+        sumSquaresRestAvx512(x1, i, dim, a10, a11);
+        sumSquaresRestAvx512(x2, i, dim, a20, a21);
+        sumSquaresRestAvx512(x3, i, dim, a30, a31);
+        _mm256_storeu_pd(out + r, hsum4Avx512(_mm512_add_pd(a00, a01), _mm512_add_pd(a10, a11),
+                                              _mm512_add_pd(a20, a21), _mm512_add_pd(a30, a31)));
+    }
+    for (; r < count; ++r)
+        out[r] = sumSquaresAvx512(rows + r * stride, dim);
+}
+
+__attribute__((target("avx512f"))) inline void rosenbrockRowsAvx512(const double *rows, std::size_t stride, std::size_t dim,
+                                                                    std::size_t count, double *out)
+{
+    std::size_t r = 0;
+    for (; r + 4 <= count; r += 4)
+    {
+        const double *x0 = rows + r * stride, *x1 = x0 + stride, *x2 = x1 + stride, *x3 = x2 + stride;
+        __m512d a00 = _mm512_setzero_pd(), a01 = a00, a10 = a00, a11 = a00, a20 = a00, a21 = a00, a30 = a00, a31 = a00;
+        std::size_t i = 0;
+        for (; i + 8 < dim; i += 8)
+        {
+            rosenbrockStepAvx512(x0 + i, a00, a01);
+            rosenbrockStepAvx512(x1 + i, a10, a11);
+            rosenbrockStepAvx512(x2 + i, a20, a21);
+            rosenbrockStepAvx512(x3 + i, a30, a31);
+        }
+        _mm256_storeu_pd(out + r, hsum4Avx512(_mm512_add_pd(a00, a01), _mm512_add_pd(a10, a11),
+                                              _mm512_add_pd(a20, a21), _mm512_add_pd(a30, a31)));
+        rosenbrockTail4(x0, stride, i, dim, out + r);
+    }
+    for (; r < count; ++r)
+        out[r] = rosenbrockAvx512(rows + r * stride, dim);
+}
+#endif
+
+// ----------------------------------------------------
+// Tabla de núcleos elegida al arrancar
+// ----------------------------------------------------
+struct RealKernels
+{
+    double (*sumSquares)(const double *, std::size_t);
+    double (*rosenbrock)(const double *, std::size_t);
+    double (*schwefel)(const double *, std::size_t);
+    // Versiones por lotes (ver RowsKernel)
+    RowsKernel sumSquaresRows;
+    RowsKernel rosenbrockRows;
+    RowsKernel schwefelRows;
+};
+
+inline RealKernels selectRealKernels(SimdLevel level)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    switch (level)
+    {
+    case SIMD_AVX512:
+        return RealKernels{sumSquaresAvx512, rosenbrockAvx512, schwefelAvx512,
+                           sumSquaresRowsAvx512, rosenbrockRowsAvx512, rowsByRow<schwefelAvx512>};
+    case SIMD_AVX2:
+        return RealKernels{sumSquaresAvx2, rosenbrockAvx2, schwefelAvx2,
+                           sumSquaresRowsAvx2, rosenbrockRowsAvx2, rowsByRow<schwefelAvx2>};
+    case SIMD_SSE2:
+        return RealKernels{sumSquaresSse2, rosenbrockSse2, schwefelSse2,
+                           rowsByRow<sumSquaresSse2>, rowsByRow<rosenbrockSse2>, rowsByRow<schwefelSse2>};
+    default:
+        break;
+    }
+#else
+    (void)level;
+#endif
+    return RealKernels{sumSquaresScalar, rosenbrockScalar, schwefelScalar,
+                       rowsByRow<sumSquaresScalar>, rowsByRow<rosenbrockScalar>, rowsByRow<schwefelScalar>};
+}
+
+inline const RealKernels &realKernels()
+{
+    static const RealKernels k = selectRealKernels(simdLevel());
+    return k;
+}
@@ -1,137 +1,24 @@
 /**
  * @file sphere_sbx.cpp
- * compilar: c++ sphere_sbx.cpp -I../eo/src -std=c++17 -L./lib/ -leo -leoutils -o sphere_sbx
- * ejecutar: ./sphere_sbx -p <poblacion> -c <cruce> -m <mutacion> -i <id>
+ * compilar: c++ sphere_sbx.cpp -O2 -std=c++17 -pthread -o sphere_sbx
+ * ejecutar: ./sphere_sbx -p <poblacion> -c <cruce> -m <mutacion> -i <id> [-ms <0|1>] [-t <hilos>] [-s <semilla>] [-be <0|1>]
  */
 
-#include <eo>
 #include <iostream>
-#include <vector>
 #include <algorithm>
-#include <chrono>
-#include <unistd.h>
-#include <fstream>
 #include <cstring>
 #include <cstdlib>
 #include <string>
 #include <ctime>
-#include <iomanip>
-#include <sstream>
 
-using namespace std;
-
-// ----------------------------------------------------
-// Individuo: vector de reales con fitness a maximizar
-struct Sphere : public EO<eoMaximizingFitness>
-{
-    vector<double> x;
-    Sphere() {}
-    Sphere(size_t n) : x(n, 0.0) {}
-    void printOn(ostream &os) const override
-    {
-        for (double v : x)
-            os << v << " ";
-    }
-    void readFrom(istream &is) override
-    {
-        for (auto &v : x)
-            is >> v;
-    }
-};
-
-// ----------------------------------------------------
-// Evaluador real de Sphere: suma de cuadrados escalada a [0,1]
-struct SphereFunction : public eoEvalFunc<Sphere>
-{
-    static constexpr double LOW = -5.12;
-    static constexpr double UP = 5.12;
-    static constexpr size_t N = 1024;
-    static constexpr double FMAX = N * UP * UP;
-    void operator()(Sphere &ind) override
-    {
-        double raw = 0.0;
-        for (double v : ind.x)
-            raw += v * v;
-        double scaled = (1.0 - raw / FMAX);
-        ind.fitness(scaled);
-    }
-};
+#include "energy_meter.h"
+#include "perf_counters.h"
+#include "problems.h"
+#include "result_rows.h"
+#include "thread_pool.h"
+#include "trace_writer.h"
 
-// ----------------------------------------------------
-// Inicializador: vectores uniformes en [LOW,UP]
-struct SphereInit : public eoInit<Sphere>
-{
-    void operator()(Sphere &ind) override
-    {
-        ind.x.resize(SphereFunction::N);
-        for (double &v : ind.x)
-        {
-            v = rng.uniform(SphereFunction::LOW, SphereFunction::UP);
-        }
-    }
-};
-
-// ----------------------------------------------------
-// SBX Crossover
-struct SBXCrossover : public eoQuadOp<Sphere>
-{
-    double eta;
-    SBXCrossover(double _eta) : eta(_eta) {}
-    bool operator()(Sphere &a, Sphere &b) override
-    {
-        const size_t n = a.x.size();
-        for (size_t i = 0; i < n; ++i)
-        {
-            double u = rng.uniform();
-            double beta = (u <= 0.5)
-                              ? pow(2.0 * u, 1.0 / (eta + 1.0))
-                              : pow(1.0 / (2.0 * (1.0 - u)), 1.0 / (eta + 1.0));
-            double c1 = 0.5 * ((1 + beta) * a.x[i] + (1 - beta) * b.x[i]);
-            double c2 = 0.5 * ((1 - beta) * a.x[i] + (1 + beta) * b.x[i]);
-            a.x[i] = min(max(c1, SphereFunction::LOW), SphereFunction::UP);
-            b.x[i] = min(max(c2, SphereFunction::LOW), SphereFunction::UP);
-        }
-        return true;
-    }
-};
-
-// ----------------------------------------------------
-// Mutación polinómica
-struct PolyMutation : public eoMonOp<Sphere>
-{
-    double pm, eta;
-    PolyMutation(double _pm, double _eta) : pm(_pm), eta(_eta) {}
-    bool operator()(Sphere &ind) override
-    {
-        bool mutated = false;
-        const size_t n = ind.x.size();
-        for (size_t i = 0; i < n; ++i)
-        {
-            if (rng.uniform() < pm)
-            {
-                double u = rng.uniform();
-                double delta = (u < 0.5)
-                                   ? pow(2.0 * u, 1.0 / (eta + 1.0)) - 1.0
-                                   : 1.0 - pow(2.0 * (1.0 - u), 1.0 / (eta + 1.0));
-                double v = ind.x[i] + delta * (SphereFunction::UP - SphereFunction::LOW);
-                ind.x[i] = min(max(v, SphereFunction::LOW), SphereFunction::UP);
-                mutated = true;
-            }
-        }
-        return mutated;
-    }
-};
-
-// ----------------------------------------------------
-// Obtener fecha y hora actual formateada
-string getCurrentDateTime()
-{
-    auto now = chrono::system_clock::now();
-    auto nowTime = chrono::system_clock::to_time_t(now);
-    stringstream ss;
-    ss << put_time(localtime(&nowTime), "%Y-%m-%d_%H-%M-%S");
-    return ss.str();
-}
+using namespace std;
 
 // ----------------------------------------------------
 int main(int argc, char **argv)
@@ -139,6 +26,10 @@ int main(int argc, char **argv)
     size_t popSize = 1024;
     double pc = 0.8, pm = 0.1;
     int id = 1;
+    bool skipSampling = false;
+    size_t nThreads = 1;
+    uint32_t seed = 0;
+    bool batchEval = true;
     for (int i = 1; i < argc; ++i)
     {
         if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
@@ -149,113 +40,81 @@ int main(int argc, char **argv)
             pm = stod(argv[++i]);
         else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc)
             id = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-ms") == 0 && i + 1 < argc)
+            skipSampling = atoi(argv[++i]) != 0;
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            nThreads = max<size_t>(1, stoul(argv[++i]));
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            seed = (uint32_t)stoul(argv[++i]);
+        else if (strcmp(argv[i], "-be") == 0 && i + 1 < argc)
+            batchEval = atoi(argv[++i]) != 0;
     }
 
-    SphereInit init;
-    SphereFunction eval;
-    SBXCrossover xover(20.0);
-    PolyMutation mutate(pm, 20.0);
-    eoDetTournamentSelect<Sphere> select(2);
-
-    // Población inicial
-    eoPop<Sphere> pop;
-    pop.reserve(popSize);
-    for (size_t i = 0; i < popSize; ++i)
-    {
-        Sphere ind;
-        init(ind);
-        eval(ind);
-        pop.push_back(ind);
-    }
-
-    // Fitness inicial máximo
-    double initMax = double(pop[0].fitness());
-    for (auto &ind : pop)
-        initMax = max(initMax, double(ind.fitness()));
-    double bestFit = initMax;
-    size_t genBest = 0;
-
-    // CSV
-    ofstream csv("sphere_results.csv", ios::app);
-    if (csv.tellp() == 0)
-        csv << "fecha_hora,framework,tamanio_individuo,poblacion,cruce,mutacion,generacion,fitness_inicial,variacion_fitness,fitness_maximo,generacion_mejor,tiempo_transcurrido,motivo_parada,ubicacion_ejecucion\n";
-
-    // Obtener fecha y hora actual
-    string dateTime = getCurrentDateTime();
+    // Motor genético único (ga_engine.h) con las políticas de Sphere (problems.h):
+    // generadores por contador con clave (semilla, id de ejecución), así que el
+    // resultado no depende del número de hilos
+    const size_t N = 1024;
+    ThreadPool pool(nThreads);
+    // Contadores hardware del bucle (perf_counters.h), solo con PARADISEO_PERF=1
+    PerfCounters perf(pool);
+    GaConfig cfg;
+    cfg.popSize = popSize;
+    cfg.crossoverRate = pc;
+    cfg.seed = seed;
+    cfg.runId = uint32_t(id);
+    cfg.batchEval = batchEval;
+    cfg.maxSeconds = 120;
+
+    // Fecha y hora de inicio
+    time_t started = time(nullptr);
+
+    // Energía RAPL por fases (energy_meter.h): inicialización, bucle y salida
+    EnergyMeter meter;
+    PhaseEnergy energy(meter);
+    energy.begin(PHASE_INIT);
+
+    SphereGA ga(cfg, SphereProblem(N), SBXCrossover(20.0, SphereProblem::LOWER, SphereProblem::UPPER),
+                PolyMutation(pm, 20.0, SphereProblem::LOWER, SphereProblem::UPPER, skipSampling), pool);
 
     // Bucle principal
-    auto t0 = chrono::steady_clock::now();
-    const int maxTime = 120;
-    string stop = "timeout";
-    size_t gen = 0;
-    while (true)
+    // Traza de convergencia por generación (trace_writer.h), solo con PARADISEO_TRACE
+    TraceWriter trace("sphere");
+    trace.begin(cfg);
+    GaResult result = ga.run([&energy, &perf, &trace](size_t gen, const GaResult &r)
     {
-        auto dt = chrono::duration_cast<chrono::seconds>(
-                      chrono::steady_clock::now() - t0)
-                      .count();
-        if (dt >= maxTime)
-        {
-            stop = "timeout";
-            break;
-        }
-        ++gen;
-        eoPop<Sphere> offspring;
-        offspring.reserve(popSize);
-        while (offspring.size() < popSize)
-        {
-            Sphere p1 = select(pop);
-            Sphere p2 = select(pop);
-            if (rng.uniform() < pc)
-                xover(p1, p2);
-            mutate(p1);
-            mutate(p2);
-            eval(p1);
-            eval(p2);
-            offspring.push_back(p1);
-            if (offspring.size() < popSize)
-                offspring.push_back(p2);
-        }
-        pop = offspring;
-        for (auto &ind : pop)
+        if (gen == 1)
         {
-            double f = double(ind.fitness());
-            if (f > bestFit)
-            {
-                bestFit = f;
-                genBest = gen;
-                if (bestFit >= 100.0)
-                {
-                    stop = "convergence";
-                    break;
-                }
-            }
+            energy.begin(PHASE_LOOP);
+            perf.start();
         }
-        if (bestFit >= 100.0)
-            break;
-    }
-
-    auto t1 = chrono::steady_clock::now();
-    double timeSec = chrono::duration_cast<chrono::seconds>(t1 - t0).count();
-    double var = bestFit - initMax;
-    char host[256];
-    gethostname(host, sizeof(host));
-
-    // Escritura en CSV
-    csv << dateTime << ","          // fecha_hora
-        << "Paradiseo" << ","       // framework
-        << SphereFunction::N << "," // tamanio_individuo
-        << popSize << ","           // poblacion
-        << pc << ","                // cruce
-        << pm << ","                // mutacion
-        << gen << ","               // generacion
-        << initMax << ","           // fitness_inicial
-        << var << ","               // variacion_fitness
-        << bestFit << ","           // fitness_maximo
-        << genBest << ","           // generacion_mejor
-        << timeSec << ","           // tiempo_transcurrido
-        << stop << ","              // motivo_parada
-        << host << "\n";            // ubicacion_ejecucion
+        trace.record(r);
+    });
+    trace.record(result);
+    perf.stop();
+    energy.begin(PHASE_OUTPUT);
+    energy.end();
+    if (meter.available())
+        cout << "Energía: " << energy.total().total() << " J (bucle "
+             << energy.phase(PHASE_LOOP).total() << " J) | fitness/kWh="
+             << fitnessPerKwh(result.bestFitness, energy.total().total()) << endl;
+
+    // Escritura en CSV (sphere_results.csv, result_rows.h)
+    RunRecord rec;
+    rec.problem = "sphere";
+    rec.dim = N;
+    rec.popSize = popSize;
+    rec.crossoverRate = pc;
+    rec.mutationRate = pm;
+    rec.runId = id;
+    rec.threads = nThreads;
+    rec.seed = cfg.seed;
+    rec.eliteCount = cfg.eliteCount;
+    rec.started = started;
+    rec.result = result;
+    rec.counters = perf.read();
+    for (int ph = 0; ph < PHASE_COUNT; ++ph)
+        rec.energy[ph] = energy.phase(EnergyPhase(ph));
+    appendResultRow(rec);
 
-    csv.close();
     return 0;
 }
@@ -0,0 +1,183 @@
+/**
+ * @file test_energy_meter.cpp
+ * @brief Prueba de EnergyMeter (energy_meter.h) sobre árboles powercap falsos: qué zonas
+ *        se suman y cómo se corrige la vuelta de los contadores.
+ * compilar: c++ test_energy_meter.cpp -O2 -std=c++17 -o test_energy_meter
+ * ejecutar: ./test_energy_meter   (código de salida 0 si todo es correcto)
+ *
+ * Cada caso monta un directorio temporal con la forma de /sys/class/powercap (name,
+ * energy_uj y max_energy_range_uj de cada zona) y construye el medidor sobre él:
+ *  - DRAM como zona de primer nivel (intel-rapl:0:0) y dentro del paquete, y las dos
+ *    a la vez (como los enlaces de sysfs), que deben contarse una sola vez;
+ *  - las subzonas core y uncore no se suman;
+ *  - la zona psys (plataforma entera) no se cuenta como paquete;
+ *  - la energía entre dos lecturas cuando un contador pasa por max_energy_range_uj.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <ftw.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "energy_meter.h"
+#include "test_stats.h"
+
+using namespace std;
+
+// Árbol powercap falso en un directorio temporal, borrado al destruirse
+class FakePowercap
+{
+public:
+    FakePowercap()
+    {
+        char tmpl[] = "/tmp/powercap_XXXXXX";
+        const char *d = mkdtemp(tmpl);
+        root = d ? d : "";
+    }
+
+    ~FakePowercap()
+    {
+        if (!root.empty())
+            nftw(root.c_str(), removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+    }
+
+    // Zona en la ruta relativa path (p. ej. "intel-rapl:0/intel-rapl:0:0")
+    void zone(const string &path, const string &name, uint64_t energy, uint64_t range = 262143328850)
+    {
+        string dir = root + "/" + path;
+        mkdir(dir.c_str(), 0755);
+        ofstream(dir + "/name") << name << "\n";
+        ofstream(dir + "/max_energy_range_uj") << range << "\n";
+        setEnergy(path, energy);
+    }
+
+    void setEnergy(const string &path, uint64_t energy) { ofstream(root + "/" + path + "/energy_uj") << energy << "\n"; }
+
+    string root;
+
+private:
+    static int removeEntry(const char *path, const struct stat *, int, struct FTW *)
+    {
+        return remove(path);
+    }
+};
+
+static bool near(double a, double b) { return fabs(a - b) <= 1e-9; }
+
+// Zonas detectadas y energía entre dos lecturas tras sumar delta a cada zona
+static void checkZones(TestReport &report, const char *what, FakePowercap &fake, size_t packages, size_t drams)
+{
+    EnergyMeter meter(fake.root);
+    char line[256];
+    snprintf(line, sizeof(line), "%-26s %zu zonas de paquete y %zu DRAM (esperadas %zu y %zu)", what,
+             meter.packageZones(), meter.dramZones(), packages, drams);
+    report.check(meter.packageZones() == packages && meter.dramZones() == drams, line);
+}
+
+int main()
+{
+    TestReport report;
+    char line[256];
+
+    {
+        FakePowercap fake;
+        EnergyMeter meter(fake.root + "/no_existe");
+        report.check(!meter.available() && meter.read().empty(), "raíz inexistente: sin zonas");
+    }
+
+    {
+        FakePowercap fake;
+        fake.zone("intel-rapl:0", "package-0", 1000000);
+        fake.zone("intel-rapl:0:0", "dram", 500000);
+        checkZones(report, "DRAM de primer nivel", fake, 1, 1);
+        EnergyMeter meter(fake.root);
+        EnergyMeter::Sample from = meter.read();
+        fake.setEnergy("intel-rapl:0", 3500000);
+        fake.setEnergy("intel-rapl:0:0", 750000);
+        EnergyReading r = meter.between(from, meter.read());
+        snprintf(line, sizeof(line), "DRAM de primer nivel       paquete %.3f J y DRAM %.3f J (esperados 2.5 y 0.25)",
+                 r.package, r.dram);
+        report.check(near(r.package, 2.5) && near(r.dram, 0.25), line);
+    }
+
+    {
+        FakePowercap fake;
+        fake.zone("intel-rapl:0", "package-0", 0);
+        fake.zone("intel-rapl:0/intel-rapl:0:0", "dram", 0);
+        checkZones(report, "DRAM dentro del paquete", fake, 1, 1);
+        EnergyMeter meter(fake.root);
+        EnergyMeter::Sample from = meter.read();
+        fake.setEnergy("intel-rapl:0/intel-rapl:0:0", 2000000);
+        EnergyReading r = meter.between(from, meter.read());
+        snprintf(line, sizeof(line), "DRAM dentro del paquete    DRAM %.3f J (esperado 2)", r.dram);
+        report.check(near(r.package, 0.0) && near(r.dram, 2.0), line);
+    }
+
+    {
+        // Como sysfs: la subzona aparece en el primer nivel y dentro del paquete
+        FakePowercap fake;
+        fake.zone("intel-rapl:0", "package-0", 0);
+        fake.zone("intel-rapl:0:0", "dram", 0);
+        fake.zone("intel-rapl:0/intel-rapl:0:0", "dram", 0);
+        checkZones(report, "DRAM en los dos sitios", fake, 1, 1);
+    }
+
+    {
+        FakePowercap fake;
+        fake.zone("intel-rapl:0", "package-0", 0);
+        fake.zone("intel-rapl:0:0", "core", 0);
+        fake.zone("intel-rapl:0:1", "uncore", 0);
+        fake.zone("intel-rapl:0/intel-rapl:0:2", "core", 0);
+        fake.zone("intel-rapl:0/intel-rapl:0:3", "uncore", 0);
+        checkZones(report, "core y uncore", fake, 1, 0);
+        EnergyMeter meter(fake.root);
+        EnergyMeter::Sample from = meter.read();
+        fake.setEnergy("intel-rapl:0", 1000000);
+        fake.setEnergy("intel-rapl:0:0", 700000);
+        fake.setEnergy("intel-rapl:0:1", 200000);
+        EnergyReading r = meter.between(from, meter.read());
+        snprintf(line, sizeof(line), "core y uncore              total %.3f J (esperado 1, solo el paquete)", r.total());
+        report.check(near(r.total(), 1.0), line);
+    }
+
+    {
+        // Portátil (i7-7500U): intel-rapl:1 es psys y ya incluye el paquete
+        FakePowercap fake;
+        fake.zone("intel-rapl:0", "package-0", 0);
+        fake.zone("intel-rapl:0:0", "core", 0);
+        fake.zone("intel-rapl:1", "psys", 0);
+        checkZones(report, "psys", fake, 1, 0);
+        EnergyMeter meter(fake.root);
+        EnergyMeter::Sample from = meter.read();
+        fake.setEnergy("intel-rapl:0", 4000000);
+        fake.setEnergy("intel-rapl:1", 9000000);
+        EnergyReading r = meter.between(from, meter.read());
+        snprintf(line, sizeof(line), "psys                       total %.3f J (esperado 4, sin la plataforma)", r.total());
+        report.check(near(r.total(), 4.0), line);
+    }
+
+    {
+        // Dos paquetes, uno de ellos con vuelta del contador
+        FakePowercap fake;
+        fake.zone("intel-rapl:0", "package-0", 999000000, 1000000000);
+        fake.zone("intel-rapl:1", "package-1", 10, 1000000000);
+        fake.zone("intel-rapl:0:0", "dram", 65000, 65536);
+        checkZones(report, "vuelta del contador", fake, 2, 1);
+        EnergyMeter meter(fake.root);
+        EnergyMeter::Sample from = meter.read();
+        fake.setEnergy("intel-rapl:0", 2000000);
+        fake.setEnergy("intel-rapl:1", 1000010);
+        fake.setEnergy("intel-rapl:0:0", 464);
+        EnergyReading r = meter.between(from, meter.read());
+        snprintf(line, sizeof(line), "vuelta del contador        paquete %.3f J y DRAM %.6f J (esperados 4 y 0.001)",
+                 r.package, r.dram);
+        report.check(near(r.package, 4.0) && near(r.dram, 0.001), line);
+    }
+
+    return report.finish();
+}
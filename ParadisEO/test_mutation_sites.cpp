@@ -0,0 +1,151 @@
+/**
+ * @file test_mutation_sites.cpp
+ * @brief Prueba de GeometricSiteSampler (mutation_sites.h): el número de genes mutados
+ *        por saltos geométricos y por una moneda por gen debe seguir Binomial(dim, pm).
+ * compilar: c++ test_mutation_sites.cpp -O2 -std=c++17 -o test_mutation_sites
+ * ejecutar: ./test_mutation_sites   (código de salida 0 si todo es correcto)
+ *
+ * Para varios pares (pm, dim) se sortean DRAWS genomas por cada camino, cada uno con su
+ * generador por contador (counter_rng.h) como en el bucle genético, y se comparan con
+ * la binomial la media, la varianza (a menos de 5 errores típicos) y el histograma de
+ * recuentos (chi-cuadrado al nivel 1e-4). En el camino geométrico se comprueba además
+ * que cada posición muta con probabilidad pm (chi-cuadrado de las frecuencias por gen).
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "counter_rng.h"
+#include "mutation_sites.h"
+#include "test_stats.h"
+
+using namespace std;
+
+static constexpr size_t DRAWS = 200000;
+
+struct Case
+{
+    size_t dim;
+    double pm;
+};
+
+// Recuentos de genes mutados de DRAWS genomas y frecuencia de cada posición
+struct Sample
+{
+    vector<double> histogram;
+    vector<double> perSite;
+    double mean = 0.0, variance = 0.0;
+};
+
+static void finishSample(Sample &s, const vector<size_t> &counts)
+{
+    double sum = 0.0, sum2 = 0.0;
+    for (size_t c : counts)
+    {
+        s.histogram[c] += 1.0;
+        sum += double(c);
+    }
+    s.mean = sum / double(counts.size());
+    for (size_t c : counts)
+        sum2 += (double(c) - s.mean) * (double(c) - s.mean);
+    s.variance = sum2 / double(counts.size() - 1);
+}
+
+static Sample geometricSample(const Case &c, uint64_t key)
+{
+    Sample s;
+    s.histogram.assign(c.dim + 1, 0.0);
+    s.perSite.assign(c.dim, 0.0);
+    GeometricSiteSampler sites(c.pm);
+    vector<size_t> counts(DRAWS);
+    for (size_t d = 0; d < DRAWS; ++d)
+    {
+        CounterRng g(key, 0, uint32_t(d), RNG_STREAM_BREED);
+        size_t k = 0;
+        sites.forEach(c.dim, g, [&](size_t i)
+                      {
+                          ++k;
+                          s.perSite[i] += 1.0;
+                      });
+        counts[d] = k;
+    }
+    finishSample(s, counts);
+    return s;
+}
+
+// Una moneda por gen, sorteadas en bloque como BitFlipMutation sin skipSampling
+static Sample bernoulliSample(const Case &c, uint64_t key)
+{
+    Sample s;
+    s.histogram.assign(c.dim + 1, 0.0);
+    s.perSite.assign(c.dim, 0.0);
+    vector<double> coin(c.dim);
+    vector<size_t> counts(DRAWS);
+    for (size_t d = 0; d < DRAWS; ++d)
+    {
+        CounterRng g(key, 0, uint32_t(d), RNG_STREAM_BREED);
+        fillUniform(g, coin.data(), c.dim);
+        size_t k = 0;
+        for (size_t i = 0; i < c.dim; ++i)
+        {
+            if (coin[i] < c.pm)
+            {
+                ++k;
+                s.perSite[i] += 1.0;
+            }
+        }
+        counts[d] = k;
+    }
+    finishSample(s, counts);
+    return s;
+}
+
+static void checkSample(TestReport &report, const char *path, const Case &c, const Sample &s)
+{
+    const double n = double(c.dim), p = c.pm, q = 1.0 - p, N = double(DRAWS);
+    const double mu = n * p, var = n * p * q;
+    // Cuarto momento central de la binomial, para el error típico de la varianza muestral
+    const double mu4 = var * (1.0 + 3.0 * (n - 2.0) * p * q);
+    const double zMean = (s.mean - mu) / sqrt(var / N);
+    const double zVar = (s.variance - var) / sqrt((mu4 - var * var) / N);
+
+    vector<double> expected(c.dim + 1);
+    for (size_t k = 0; k <= c.dim; ++k)
+        expected[k] = binomialPmf(c.dim, p, k);
+    size_t df = 0;
+    const double chi = chiSquare(s.histogram, expected, N, df);
+    const double crit = chiSquareCritical(df);
+
+    char line[256];
+    snprintf(line, sizeof(line), "%-10s dim=%-5zu pm=%-6g media=%.4f (z=%+.2f) varianza=%.4f (z=%+.2f)", path, c.dim,
+             p, s.mean, zMean, s.variance, zVar);
+    report.check(fabs(zMean) < 5.0 && fabs(zVar) < 5.0, line);
+    snprintf(line, sizeof(line), "%-10s dim=%-5zu pm=%-6g chi2 recuentos=%.1f (gl=%zu, crítico %.1f)", path, c.dim, p,
+             chi, df, crit);
+    report.check(chi < crit, line);
+
+    // Cada posición muta con probabilidad pm de forma independiente entre genomas
+    double chiSites = 0.0;
+    for (double f : s.perSite)
+        chiSites += (f - N * p) * (f - N * p) / (N * p * q);
+    snprintf(line, sizeof(line), "%-10s dim=%-5zu pm=%-6g chi2 posiciones=%.1f (gl=%zu, crítico %.1f)", path, c.dim,
+             p, chiSites, c.dim, chiSquareCritical(c.dim));
+    report.check(chiSites < chiSquareCritical(c.dim), line);
+}
+
+int main()
+{
+    const Case cases[] = {{1024, 0.001}, {1024, 0.01}, {1024, 0.1}, {256, 0.05}, {64, 0.3}, {16, 0.9}};
+    TestReport report;
+    cout << "Recuento de genes mutados frente a Binomial(dim, pm), " << DRAWS << " genomas por caso" << endl;
+    for (const Case &c : cases)
+    {
+        checkSample(report, "geométrico", c, geometricSample(c, counterRngKey(12345, 1)));
+        checkSample(report, "por gen", c, bernoulliSample(c, counterRngKey(12345, 2)));
+    }
+    return report.finish();
+}
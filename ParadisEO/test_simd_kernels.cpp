@@ -0,0 +1,281 @@
+/**
+ * @file test_simd_kernels.cpp
+ * @brief Prueba de los núcleos SIMD de las funciones objetivo (simd_kernels.h) frente a
+ *        la ruta escalar: cotas de error documentadas y ordenación de un corpus fijo.
+ * compilar: c++ test_simd_kernels.cpp -O2 -std=c++17 -o test_simd_kernels
+ * ejecutar: ./test_simd_kernels   (código de salida 0 si todo es correcto)
+ *
+ * Se prueban todos los niveles que permite simdLevel() (PARADISEO_SIMD puede limitarlo).
+ * El corpus de referencia se genera con semilla fija (counter_rng.h): individuos de
+ * dimensión 1024 uniformes en el dominio, cerca del óptimo y, en Schwefel, con genes en
+ * los extremos, en 0 y por debajo de 1e-10 (que la referencia omite). Para cada nivel:
+ *  - cada valor está dentro de la cota de la cabecera de simd_kernels.h
+ *    (Sphere 2 (n+2) u S, Rosenbrock 4 (n+2) u M, Schwefel (n+10) u A);
+ *  - en Schwefel cada término x sin(sqrt|x|) difiere menos de 8 u |x| de la referencia,
+ *    sobre un barrido de [-500, 500] y los valores especiales;
+ *  - la evaluación por lotes da exactamente el valor del núcleo individual;
+ *  - ordenar el corpus por el valor del núcleo da el mismo orden que por el escalar
+ *    (solo se admitiría un cambio entre individuos cuyos valores de referencia se
+ *    separen menos que la suma de sus cotas).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "counter_rng.h"
+#include "simd_kernels.h"
+#include "test_stats.h"
+
+using namespace std;
+
+static constexpr size_t DIM = 1024;
+static constexpr double U = 1.1102230246251565e-16; // 2^-53
+static constexpr double SCHWEFEL_OPTIMUM = 420.9687;
+
+// Corpus: filas de DIM genes
+struct Corpus
+{
+    string name;
+    vector<double> genes;
+    size_t rows() const { return genes.size() / DIM; }
+    const double *row(size_t i) const { return genes.data() + i * DIM; }
+};
+
+static Corpus uniformCorpus(const char *name, size_t rows, double lo, double hi, uint32_t stream)
+{
+    Corpus c{name, vector<double>(rows * DIM)};
+    for (size_t i = 0; i < rows; ++i)
+    {
+        CounterRng g(counterRngKey(2024, 7), 0, uint32_t(i), stream);
+        g.fillUniform(c.genes.data() + i * DIM, DIM, lo, hi);
+    }
+    return c;
+}
+
+// Alrededor de center con desviación sigma, recortado a [lo, hi]
+static Corpus nearCorpus(const char *name, size_t rows, double center, double sigma, double lo, double hi,
+                         uint32_t stream)
+{
+    Corpus c{name, vector<double>(rows * DIM)};
+    for (size_t i = 0; i < rows; ++i)
+    {
+        CounterRng g(counterRngKey(2024, 7), 0, uint32_t(i), stream);
+        for (size_t j = 0; j < DIM; ++j)
+            c.genes[i * DIM + j] = min(hi, max(lo, center + sigma * g.normal()));
+    }
+    return c;
+}
+
+// Schwefel: cada gen es un valor especial o uniforme
+static Corpus schwefelEdgeCorpus(size_t rows, uint32_t stream)
+{
+    static const double special[] = {-500.0, 500.0, 0.0, 1e-11, -1e-11, 5e-11, SCHWEFEL_OPTIMUM,
+                                     -SCHWEFEL_OPTIMUM, 1e-300, -302.5249, 499.9999999};
+    const size_t nSpecial = sizeof(special) / sizeof(special[0]);
+    Corpus c{"extremos", vector<double>(rows * DIM)};
+    for (size_t i = 0; i < rows; ++i)
+    {
+        CounterRng g(counterRngKey(2024, 7), 0, uint32_t(i), stream);
+        for (size_t j = 0; j < DIM; ++j)
+        {
+            size_t k = g.random(uint32_t(2 * nSpecial));
+            c.genes[i * DIM + j] = k < nSpecial ? special[k] : g.uniform(-500.0, 500.0);
+        }
+    }
+    return c;
+}
+
+// ----------------------------------------------------
+// Cotas de la cabecera de simd_kernels.h para el valor de referencia s de x
+// ----------------------------------------------------
+static double sphereBound(const double *, size_t n, double s) { return 2.0 * double(n + 2) * U * s; }
+
+static double rosenbrockBound(const double *x, size_t n, double)
+{
+    double m = 0.0;
+    for (size_t i = 0; i + 1 < n; ++i)
+    {
+        double a = fabs(x[i + 1]) + x[i] * x[i], b = fabs(x[i]) + 1.0;
+        m += 100.0 * a * a + b * b;
+    }
+    return 4.0 * double(n + 2) * U * m;
+}
+
+static double schwefelBound(const double *x, size_t n, double)
+{
+    double a = SCHWEFEL_ALPHA * double(n);
+    for (size_t i = 0; i < n; ++i)
+        a += fabs(x[i]);
+    return double(n + 10) * U * a;
+}
+
+typedef double (*ObjectiveKernel)(const double *, size_t);
+
+struct Objective
+{
+    const char *name;
+    ObjectiveKernel scalar;
+    ObjectiveKernel RealKernels::*single;
+    RowsKernel RealKernels::*rows;
+    double (*bound)(const double *, size_t, double);
+    vector<Corpus> corpora;
+};
+
+// Comprueba cotas, lotes y ordenación de un objetivo en un nivel
+static void checkObjective(TestReport &report, SimdLevel level, const Objective &obj)
+{
+    const RealKernels k = selectRealKernels(level);
+    char line[256];
+    for (const Corpus &c : obj.corpora)
+    {
+        const size_t n = c.rows();
+        vector<double> ref(n), got(n), bound(n), batch(n);
+        double worst = 0.0;
+        bool within = true;
+        for (size_t i = 0; i < n; ++i)
+        {
+            ref[i] = obj.scalar(c.row(i), DIM);
+            got[i] = (k.*(obj.single))(c.row(i), DIM);
+            bound[i] = obj.bound(c.row(i), DIM, ref[i]);
+            double err = fabs(got[i] - ref[i]);
+            within = within && err <= bound[i];
+            worst = max(worst, bound[i] > 0.0 ? err / bound[i] : (err > 0.0 ? INFINITY : 0.0));
+        }
+        snprintf(line, sizeof(line), "%-7s %-10s %-9s error dentro de la cota (máximo %.3f de la cota)",
+                 simdLevelName(level), obj.name, c.name.c_str(), worst);
+        report.check(within, line);
+
+        (k.*obj.rows)(c.genes.data(), DIM, DIM, n, batch.data());
+        snprintf(line, sizeof(line), "%-7s %-10s %-9s lotes idénticos al núcleo individual", simdLevelName(level),
+                 obj.name, c.name.c_str());
+        report.check(batch == got, line);
+
+        // Ordenación: misma permutación que con los valores de referencia
+        vector<size_t> byRef(n), byKernel(n);
+        iota(byRef.begin(), byRef.end(), size_t(0));
+        iota(byKernel.begin(), byKernel.end(), size_t(0));
+        stable_sort(byRef.begin(), byRef.end(), [&](size_t a, size_t b)
+                    { return ref[a] < ref[b]; });
+        stable_sort(byKernel.begin(), byKernel.end(), [&](size_t a, size_t b)
+                    { return got[a] < got[b]; });
+        size_t swapped = 0, unexplained = 0;
+        for (size_t i = 0; i + 1 < n; ++i)
+        {
+            size_t a = byKernel[i], b = byKernel[i + 1];
+            if (ref[a] > ref[b])
+            {
+                ++swapped;
+                if (ref[a] - ref[b] > bound[a] + bound[b])
+                    ++unexplained;
+            }
+        }
+        snprintf(line, sizeof(line), "%-7s %-10s %-9s ordenación de %zu individuos %s (%zu pares invertidos)",
+                 simdLevelName(level), obj.name, c.name.c_str(), n,
+                 byRef == byKernel ? "idéntica" : "distinta", swapped);
+        report.check(byRef == byKernel || unexplained == 0, line);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Términos x sin(sqrt|x|) de cada nivel (n múltiplo de 8)
+__attribute__((target("sse2"))) static void termsSse2(const double *x, size_t n, double *out)
+{
+    for (size_t i = 0; i < n; i += 2)
+        _mm_storeu_pd(out + i, schwefelTermSse2(_mm_loadu_pd(x + i)));
+}
+
+__attribute__((target("avx2,fma"))) static void termsAvx2(const double *x, size_t n, double *out)
+{
+    for (size_t i = 0; i < n; i += 4)
+        _mm256_storeu_pd(out + i, schwefelTermAvx2(_mm256_loadu_pd(x + i)));
+}
+
+__attribute__((target("avx512f"))) static void termsAvx512(const double *x, size_t n, double *out)
+{
+    for (size_t i = 0; i < n; i += 8)
+        _mm512_storeu_pd(out + i, schwefelTermAvx512(_mm512_loadu_pd(x + i)));
+}
+#endif
+
+static void checkSchwefelTerms(TestReport &report, SimdLevel level, const vector<double> &x)
+{
+    vector<double> out(x.size());
+#if defined(__x86_64__) || defined(__i386__)
+    if (level == SIMD_SSE2)
+        termsSse2(x.data(), x.size(), out.data());
+    else if (level == SIMD_AVX2)
+        termsAvx2(x.data(), x.size(), out.data());
+    else
+        termsAvx512(x.data(), x.size(), out.data());
+#endif
+    double worst = 0.0;
+    bool within = true;
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        double ref = x[i] * sin(sqrt(fabs(x[i])));
+        double err = fabs(out[i] - ref), bound = 8.0 * U * fabs(x[i]);
+        within = within && err <= bound;
+        if (bound > 0.0)
+            worst = max(worst, err / (U * fabs(x[i])));
+        else if (err > 0.0)
+            worst = INFINITY;
+    }
+    char line[256];
+    snprintf(line, sizeof(line), "%-7s schwefel   términos  %zu valores de [-500, 500]: error < 8 u |x| (máximo %.2f u |x|)",
+             simdLevelName(level), x.size(), worst);
+    report.check(within, line);
+}
+
+int main()
+{
+    TestReport report;
+    const SimdLevel top = simdLevel();
+    cout << "Nivel SIMD de esta máquina: " << simdLevelName(top) << endl;
+    if (top == SIMD_SCALAR)
+    {
+        cout << "Sin niveles SIMD que comparar con la referencia escalar" << endl;
+        return report.finish();
+    }
+
+    const Objective objectives[] = {
+        {"sphere", sumSquaresScalar, &RealKernels::sumSquares, &RealKernels::sumSquaresRows, sphereBound,
+         {uniformCorpus("uniforme", 2000, -5.12, 5.12, 10), nearCorpus("óptimo", 500, 0.0, 1e-3, -5.12, 5.12, 11)}},
+        {"rosenbrock", rosenbrockScalar, &RealKernels::rosenbrock, &RealKernels::rosenbrockRows, rosenbrockBound,
+         {uniformCorpus("uniforme", 2000, -2.048, 2.048, 20), nearCorpus("óptimo", 500, 1.0, 1e-3, -2.048, 2.048, 21)}},
+        {"schwefel", schwefelScalar, &RealKernels::schwefel, &RealKernels::schwefelRows, schwefelBound,
+         {uniformCorpus("uniforme", 2000, -500.0, 500.0, 30),
+          nearCorpus("óptimo", 500, SCHWEFEL_OPTIMUM, 1.0, -500.0, 500.0, 31), schwefelEdgeCorpus(500, 32)}},
+    };
+
+    // Barrido de los términos de Schwefel: rejilla de [-500, 500], valores especiales y
+    // genes del corpus uniforme
+    vector<double> sweep;
+    const size_t steps = 1 << 20;
+    for (size_t i = 0; i < steps; ++i)
+        sweep.push_back(-500.0 + 1000.0 * double(i) / double(steps - 1));
+    for (double v : {0.0, 1e-300, 1e-11, 1e-10, 1e-9, 1e-3, 1.0, 9.869604401089358, SCHWEFEL_OPTIMUM, 499.9999999})
+    {
+        sweep.push_back(v);
+        sweep.push_back(-v);
+    }
+    const Corpus &uniform = objectives[2].corpora[0];
+    sweep.insert(sweep.end(), uniform.genes.begin(), uniform.genes.end());
+    while (sweep.size() % 8)
+        sweep.push_back(0.0);
+
+    for (int l = SIMD_SSE2; l <= top; ++l)
+    {
+        const SimdLevel level = SimdLevel(l);
+        cout << "== " << simdLevelName(level) << endl;
+        for (const Objective &obj : objectives)
+            checkObjective(report, level, obj);
+        checkSchwefelTerms(report, level, sweep);
+    }
+    return report.finish();
+}
@@ -0,0 +1,123 @@
+/**
+ * @file test_stats.h
+ * @brief Estadísticos de las pruebas de los núcleos (test_mutation_sites.cpp,
+ *        test_simd_kernels.cpp, test_variation_kernels.cpp): probabilidades binomiales,
+ *        valor crítico de chi-cuadrado, Kolmogorov-Smirnov con dos muestras y el
+ *        recuento de comprobaciones fallidas que fija el código de salida (que usa
+ *        también test_energy_meter.cpp).
+ *
+ * Las pruebas usan semillas fijas, así que cada ejecución ve exactamente los mismos
+ * datos; los umbrales estadísticos son de nivel 1e-4 (chi-cuadrado) y 1e-3 (KS) para
+ * que un fallo indique un error real y no mala suerte.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// P(X = k) con X ~ Binomial(n, p), 0 < p < 1
+inline double binomialPmf(std::size_t n, double p, std::size_t k)
+{
+    double logC = std::lgamma(double(n) + 1.0) - std::lgamma(double(k) + 1.0) - std::lgamma(double(n - k) + 1.0);
+    return std::exp(logC + double(k) * std::log(p) + double(n - k) * std::log1p(-p));
+}
+
+// Valor crítico de chi-cuadrado con df grados de libertad al nivel 1e-4
+// (aproximación de Wilson-Hilferty, z = 3.719)
+inline double chiSquareCritical(std::size_t df)
+{
+    const double z = 3.719, d = double(df);
+    const double c = 1.0 - 2.0 / (9.0 * d) + z * std::sqrt(2.0 / (9.0 * d));
+    return d * c * c * c;
+}
+
+// Estadístico de chi-cuadrado de los recuentos observed frente a las probabilidades
+// expected (que suman 1) sobre total observaciones. Las clases con frecuencia
+// esperada menor que 5 se agrupan con sus vecinas; df recibe los grados de libertad
+inline double chiSquare(const std::vector<double> &observed, const std::vector<double> &expected, double total,
+                        std::size_t &df)
+{
+    std::vector<double> o, e;
+    double accO = 0.0, accE = 0.0;
+    for (std::size_t k = 0; k < observed.size(); ++k)
+    {
+        accO += observed[k];
+        accE += expected[k] * total;
+        if (accE >= 5.0)
+        {
+            o.push_back(accO);
+            e.push_back(accE);
+            accO = accE = 0.0;
+        }
+    }
+    // La cola que no llega a 5 va con la última clase
+    if (!o.empty())
+    {
+        o.back() += accO;
+        e.back() += accE;
+    }
+    double stat = 0.0;
+    for (std::size_t k = 0; k < o.size(); ++k)
+        stat += (o[k] - e[k]) * (o[k] - e[k]) / e[k];
+    df = o.size() > 1 ? o.size() - 1 : 1;
+    return stat;
+}
+
+// Estadístico D de Kolmogorov-Smirnov con dos muestras (ordena a y b)
+inline double ksTwoSample(std::vector<double> &a, std::vector<double> &b)
+{
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    std::size_t i = 0, j = 0;
+    double d = 0.0;
+    while (i < a.size() && j < b.size())
+    {
+        const double x = std::min(a[i], b[j]);
+        while (i < a.size() && a[i] <= x)
+            ++i;
+        while (j < b.size() && b[j] <= x)
+            ++j;
+        d = std::max(d, std::abs(double(i) / double(a.size()) - double(j) / double(b.size())));
+    }
+    return d;
+}
+
+// Valor crítico de D al nivel 1e-3 para muestras de tamaños n y m
+inline double ksCritical(std::size_t n, std::size_t m)
+{
+    return 1.949 * std::sqrt(double(n + m) / (double(n) * double(m)));
+}
+
+// ----------------------------------------------------
+// Recuento de comprobaciones: cada una se muestra con su resultado y main()
+// devuelve failures() != 0
+// ----------------------------------------------------
+class TestReport
+{
+public:
+    bool check(bool ok, const std::string &what)
+    {
+        std::cout << (ok ? "  ok     " : "  FALLO  ") << what << std::endl;
+        ++total;
+        if (!ok)
+            ++failed;
+        return ok;
+    }
+
+    int failures() const { return failed; }
+
+    int finish() const
+    {
+        std::cout << (failed ? "FALLO: " : "OK: ") << total - failed << " de " << total
+                  << " comprobaciones correctas" << std::endl;
+        return failed ? 1 : 0;
+    }
+
+private:
+    int total = 0;
+    int failed = 0;
+};
@@ -0,0 +1,240 @@
+/**
+ * @file test_variation_kernels.cpp
+ * @brief Prueba de los núcleos vectorizados de variación (variation_kernels.h) frente a
+ *        sbxScalar, safeSbxScalar y polyDeltaScalar: cotas de error por gen y
+ *        distribución de los hijos.
+ * compilar: c++ test_variation_kernels.cpp -O2 -std=c++17 -o test_variation_kernels
+ * ejecutar: ./test_variation_kernels   (código de salida 0 si todo es correcto)
+ *
+ * Se prueban los niveles AVX2 y AVX-512 que permita simdLevel() (por debajo de AVX2 los
+ * operadores usan la referencia escalar). Cada caso es un operador con su eta y su
+ * dominio como se usa en los binarios, sobre un conjunto fijo de padres (semilla fija,
+ * counter_rng.h) al que se añaden u en los extremos, padres iguales o separados por
+ * poco más o menos de 1e-10, padres en los límites y, en SBX seguro, padres con
+ * alpha = 2 - beta^(eta+1) casi nulo. Para cada nivel:
+ *  - con los mismos u, cada gen cumple la cota de la cabecera de variation_kernels.h;
+ *  - con u independientes, el test de Kolmogorov-Smirnov con dos muestras (nivel 1e-3)
+ *    no distingue los hijos del núcleo de los de la referencia.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include "counter_rng.h"
+#include "test_stats.h"
+#include "variation_kernels.h"
+
+using namespace std;
+
+static constexpr double U = 1.1102230246251565e-16; // 2^-53
+// Pares de genes por caso (no múltiplo de 8, para recorrer también la cola escalar)
+static constexpr size_t GENES = (1 << 20) + 5;
+// Hijos por muestra del test de Kolmogorov-Smirnov
+static constexpr size_t KS_GENES = 1000000;
+
+struct Case
+{
+    const char *name;
+    bool safe;
+    double eta, lo, hi;
+};
+
+// Padres y u de un caso
+struct Pool
+{
+    vector<double> a, b, u;
+};
+
+static Pool randomPool(const Case &c, size_t n, uint32_t stream)
+{
+    Pool p{vector<double>(n), vector<double>(n), vector<double>(n)};
+    CounterRng g(counterRngKey(2024, 9), 0, 0, stream);
+    g.fillUniform(p.a.data(), n, c.lo, c.hi);
+    g.fillUniform(p.b.data(), n, c.lo, c.hi);
+    g.fillUniform(p.u.data(), n);
+    return p;
+}
+
+// Sustituye una parte del conjunto por casos límite
+static void addEdgeCases(Pool &p, const Case &c)
+{
+    static const double edgeU[] = {0.0, 1e-300, 1e-17, 0.5, 0.50000000000000011, 0.9999999,
+                                   0.99999999999999978, 0.99999999999999989};
+    const size_t nEdgeU = sizeof(edgeU) / sizeof(edgeU[0]);
+    const double width = c.hi - c.lo;
+    for (size_t i = 0; i < p.u.size(); i += 4)
+        p.u[i] = edgeU[(i / 4) % nEdgeU];
+    for (size_t i = 1; i < p.a.size(); i += 64)
+    {
+        switch ((i / 64) % 6)
+        {
+        case 0: // padres iguales
+            p.b[i] = p.a[i];
+            break;
+        case 1: // justo por debajo y por encima del umbral de SBX seguro
+            p.b[i] = p.a[i] + 0.99e-10;
+            break;
+        case 2:
+            p.b[i] = p.a[i] + 1.01e-10;
+            break;
+        case 3: // en los límites del dominio
+            p.a[i] = c.lo;
+            break;
+        case 4:
+            p.b[i] = c.hi;
+            break;
+        case 5: // un padre en el límite inferior y el otro muy cerca
+            p.a[i] = c.lo;
+            p.b[i] = c.lo + 1e-6 * width;
+            break;
+        }
+    }
+    // alpha casi nulo: beta = 1 + 2 (y1 - lo) / (y2 - y1) = 2^(1 / (eta + 1)) (1 + t)
+    const double beta0 = pow(2.0, 1.0 / (c.eta + 1.0));
+    for (size_t i = 2; c.safe && i < p.a.size(); i += 64)
+    {
+        const double t = double(int((i / 64) % 41) - 20) * pow(10.0, -double((i / 64) % 16));
+        const double beta = beta0 * (1.0 + t);
+        const double y2 = c.lo + 0.25 * width + 0.75 * width * p.u[i + 1];
+        const double y1 = (2.0 * c.lo + (beta - 1.0) * y2) / (beta + 1.0);
+        if (y1 > c.lo && y1 < y2)
+        {
+            p.a[i] = y1;
+            p.b[i] = y2;
+        }
+    }
+}
+
+// ----------------------------------------------------
+// Escala de la cota por gen: |hijo' - hijo| <= 4 u escala
+// ----------------------------------------------------
+static double sbxScale(double a, double b, double u, double eta)
+{
+    double beta = (u <= 0.5) ? pow(2.0 * u, 1.0 / (eta + 1.0)) : pow(1.0 / (2.0 * (1.0 - u)), 1.0 / (eta + 1.0));
+    return (1.0 + beta) * (fabs(a) + fabs(b));
+}
+
+static double safeSbxScale(double a, double b, double eta, double lo)
+{
+    const double d = fabs(a - b);
+    if (d < 1e-10)
+        return 0.0; // sin cruce: los hijos son los padres
+    double beta = min(1.0 + 2.0 * (min(a, b) - lo) / d, 100.0);
+    double alpha = 2.0 - min(100.0, pow(beta, eta + 1.0));
+    return fabs(a) + fabs(b) + d / fabs(alpha);
+}
+
+static void crossover(const VariationKernels &k, bool reference, const Case &c, Pool &p)
+{
+    const size_t n = p.a.size();
+    if (c.safe)
+        (reference ? safeSbxScalar : k.safeSbx)(p.a.data(), p.b.data(), p.u.data(), n, c.eta, c.lo, c.hi);
+    else
+        (reference ? sbxScalar : k.sbx)(p.a.data(), p.b.data(), p.u.data(), n, c.eta, c.lo, c.hi);
+}
+
+static void checkCrossover(TestReport &report, SimdLevel level, const VariationKernels &k, const Case &c)
+{
+    char line[256];
+
+    // Mismos u: cota por gen
+    Pool parents = randomPool(c, GENES, 1);
+    addEdgeCases(parents, c);
+    Pool ref = parents, got = parents;
+    crossover(k, true, c, ref);
+    crossover(k, false, c, got);
+    double worst = 0.0;
+    bool within = true;
+    for (size_t i = 0; i < GENES; ++i)
+    {
+        const double scale = c.safe ? safeSbxScale(parents.a[i], parents.b[i], c.eta, c.lo)
+                                    : sbxScale(parents.a[i], parents.b[i], parents.u[i], c.eta);
+        for (double err : {fabs(got.a[i] - ref.a[i]), fabs(got.b[i] - ref.b[i])})
+        {
+            within = within && err <= 4.0 * U * scale;
+            if (scale > 0.0)
+                worst = max(worst, err / (U * scale));
+            else if (err > 0.0)
+                worst = INFINITY;
+        }
+    }
+    snprintf(line, sizeof(line), "%-7s %-18s %zu genes: error <= 4 u escala (máximo %.2f u escala)",
+             simdLevelName(level), c.name, GENES, worst);
+    report.check(within, line);
+
+    // u independientes: misma distribución de hijos
+    Pool refKs = randomPool(c, KS_GENES, 2), gotKs = refKs;
+    CounterRng g(counterRngKey(2024, 9), 0, 0, 3);
+    g.fillUniform(gotKs.u.data(), KS_GENES);
+    crossover(k, true, c, refKs);
+    crossover(k, false, c, gotKs);
+    double d = ksTwoSample(refKs.a, gotKs.a), crit = ksCritical(KS_GENES, KS_GENES);
+    snprintf(line, sizeof(line), "%-7s %-18s KS hijos D=%.5f (crítico %.5f)", simdLevelName(level), c.name, d, crit);
+    report.check(d < crit, line);
+}
+
+static void checkPolyDelta(TestReport &report, SimdLevel level, const VariationKernels &k, double eta)
+{
+    char line[256];
+    vector<double> u(GENES), ref(GENES), got(GENES);
+    CounterRng g(counterRngKey(2024, 9), 0, 0, 4);
+    g.fillUniform(u.data(), GENES);
+    static const double edgeU[] = {0.0, 1e-300, 1e-17, 0.49999999999999994, 0.5, 0.9999999, 0.99999999999999989};
+    for (size_t i = 0; i < GENES; i += 8)
+        u[i] = edgeU[(i / 8) % (sizeof(edgeU) / sizeof(edgeU[0]))];
+    polyDeltaScalar(u.data(), GENES, eta, ref.data());
+    k.polyDelta(u.data(), GENES, eta, got.data());
+    double worst = 0.0;
+    for (size_t i = 0; i < GENES; ++i)
+        worst = max(worst, fabs(got[i] - ref[i]));
+    snprintf(line, sizeof(line), "%-7s polinómica eta=%-3g %zu genes: error <= 4 u (máximo %.2f u)",
+             simdLevelName(level), eta, GENES, worst / U);
+    report.check(worst <= 4.0 * U, line);
+
+    vector<double> u2(KS_GENES), refKs(KS_GENES), gotKs(KS_GENES);
+    CounterRng g1(counterRngKey(2024, 9), 0, 0, 5), g2(counterRngKey(2024, 9), 0, 0, 6);
+    g1.fillUniform(u2.data(), KS_GENES);
+    polyDeltaScalar(u2.data(), KS_GENES, eta, refKs.data());
+    g2.fillUniform(u2.data(), KS_GENES);
+    k.polyDelta(u2.data(), KS_GENES, eta, gotKs.data());
+    double d = ksTwoSample(refKs, gotKs), crit = ksCritical(KS_GENES, KS_GENES);
+    snprintf(line, sizeof(line), "%-7s polinómica eta=%-3g KS desplazamientos D=%.5f (crítico %.5f)",
+             simdLevelName(level), eta, d, crit);
+    report.check(d < crit, line);
+}
+
+int main()
+{
+    TestReport report;
+    const SimdLevel top = simdLevel();
+    cout << "Nivel SIMD de esta máquina: " << simdLevelName(top) << endl;
+    if (top < SIMD_AVX2)
+    {
+        cout << "Los operadores usan la referencia escalar en este nivel: nada que comparar" << endl;
+        return report.finish();
+    }
+
+    // Como en los binarios: SBX en Sphere, SBX seguro en Schwefel y Rosenbrock
+    const Case cases[] = {
+        {"sbx sphere", false, 20.0, -5.12, 5.12},
+        {"sbx eta=2", false, 2.0, -500.0, 500.0},
+        {"seguro schwefel", true, 2.0, -500.0, 500.0},
+        {"seguro rosenbrock", true, 2.0, -2.048, 2.048},
+        {"seguro eta=20", true, 20.0, -500.0, 500.0},
+    };
+    for (int l = SIMD_AVX2; l <= top; ++l)
+    {
+        const SimdLevel level = SimdLevel(l);
+        const VariationKernels k = selectVariationKernels(level);
+        cout << "== " << simdLevelName(level) << endl;
+        for (const Case &c : cases)
+            checkCrossover(report, level, k, c);
+        for (double eta : {2.0, 20.0})
+            checkPolyDelta(report, level, k, eta);
+    }
+    return report.finish();
+}
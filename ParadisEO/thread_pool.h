@@ -0,0 +1,158 @@
+/**
+ * @file thread_pool.h
+ * @brief Pool de hilos fork-join para repartir la generación de descendientes.
+ *
+ * El hilo que llama actúa como trabajador 0 y los demás esperan dormidos entre
+ * generaciones. El reparto de parallelFor es estático (bloques contiguos por
+ * trabajador), así que cada trabajador procesa siempre los mismos índices en el
+ * mismo orden. Los binarios usan además un generador por contador para cada pareja
+ * (counter_rng.h), así que el resultado tampoco depende del número de hilos.
+ * La tarea se pasa como puntero más función de llamada (sin std::function), así que
+ * lanzar una generación no reserva memoria dinámica.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    // nThreads cuenta también el hilo que llama
+    explicit ThreadPool(std::size_t nThreads) : nThreads(nThreads ? nThreads : 1)
+    {
+        for (std::size_t w = 1; w < this->nThreads; ++w)
+            workers.emplace_back([this, w]
+                                 { workerLoop(w); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stop = true;
+        }
+        cvStart.notify_all();
+        for (auto &t : workers)
+            t.join();
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    std::size_t size() const { return nThreads; }
+
+    // Ejecuta job(w) para cada trabajador w en [0, size()) y espera a que acaben todos
+    template <class F>
+    void run(F &&job)
+    {
+        typedef typename std::remove_reference<F>::type Job;
+        runErased(const_cast<void *>(static_cast<const void *>(&job)), [](void *ctx, std::size_t w)
+                  { (*static_cast<Job *>(ctx))(w); });
+    }
+
+    // Llama a f(w, begin, end) con el bloque contiguo y fijo [begin, end) de [0, n)
+    // que corresponde al trabajador w
+    template <class F>
+    void parallelRange(std::size_t n, F &&f)
+    {
+        auto job = [&](std::size_t w)
+        {
+            f(w, n * w / nThreads, n * (w + 1) / nThreads);
+        };
+        run(job);
+    }
+
+    // Llama a f(w, i) para i en [0, n), con bloques contiguos y fijos por trabajador
+    template <class F>
+    void parallelFor(std::size_t n, F &&f)
+    {
+        parallelRange(n, [&](std::size_t w, std::size_t begin, std::size_t end)
+                      {
+            for (std::size_t i = begin; i < end; ++i)
+                f(w, i); });
+    }
+
+private:
+    typedef void (*TaskFn)(void *, std::size_t);
+
+    void runErased(void *ctx, TaskFn fn)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            taskCtx = ctx;
+            taskFn = fn;
+            pending = nThreads - 1;
+            error = nullptr;
+            ++epoch;
+        }
+        cvStart.notify_all();
+        try
+        {
+            fn(ctx, 0);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m);
+            if (!error)
+                error = std::current_exception();
+        }
+        std::unique_lock<std::mutex> lock(m);
+        cvDone.wait(lock, [this]
+                    { return pending == 0; });
+        taskFn = nullptr;
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    void workerLoop(std::size_t w)
+    {
+        std::size_t seen = 0;
+        while (true)
+        {
+            void *ctx;
+            TaskFn fn;
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cvStart.wait(lock, [&]
+                             { return stop || epoch != seen; });
+                if (stop)
+                    return;
+                seen = epoch;
+                ctx = taskCtx;
+                fn = taskFn;
+            }
+            try
+            {
+                fn(ctx, w);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(m);
+                if (!error)
+                    error = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock(m);
+                if (--pending == 0)
+                    cvDone.notify_one();
+            }
+        }
+    }
+
+    std::size_t nThreads;
+    std::vector<std::thread> workers;
+    std::mutex m;
+    std::condition_variable cvStart, cvDone;
+    void *taskCtx = nullptr;
+    TaskFn taskFn = nullptr;
+    std::size_t epoch = 0;
+    std::size_t pending = 0;
+    std::exception_ptr error;
+    bool stop = false;
+};
@@ -0,0 +1,293 @@
+/**
+ * @file trace_writer.h
+ * @brief Traza de convergencia por generación (mejor, media y peor fitness, mejor valor
+ *        bruto, tiempo y evaluaciones) escrita por un hilo aparte, sin bloquear nunca el
+ *        bucle generacional.
+ *
+ * Es opcional: solo se activa con la variable de entorno PARADISEO_TRACE=csv (o 1) o
+ * PARADISEO_TRACE=bin. El hilo del bucle solo copia un TraceRecord de tamaño fijo a una
+ * cola circular SPSC sin bloqueos (TraceRing); si la cola está llena el registro se
+ * descarta y se cuenta, en vez de esperar. Un hilo escritor vacía la cola cada
+ * milisegundo, da formato a los registros y los añade con write() en bloques que
+ * terminan en un registro completo a traza_<problema>_<host>.csv (texto) o .bin
+ * (binario: cabecera TraceFileHeader y registros TraceRecord tal cual).
+ *
+ * El fichero se abre con O_APPEND y cada registro lleva la ejecución (id, población,
+ * cruce, inicio e isla), así que varias ejecuciones, una campaña o las islas en
+ * procesos (shm_islands.h) pueden compartir fichero. La cabecera se escribe bajo
+ * flock(LOCK_EX), como en result_store.h, para que solo la escriba el primero.
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ga_engine.h"
+#include "result_rows.h"
+
+enum TraceFormat
+{
+    TRACE_OFF,
+    TRACE_CSV,
+    TRACE_BINARY
+};
+
+inline TraceFormat traceFormatRequested()
+{
+    const char *env = std::getenv("PARADISEO_TRACE");
+    if (!env)
+        return TRACE_OFF;
+    if (std::strcmp(env, "csv") == 0 || std::strcmp(env, "1") == 0)
+        return TRACE_CSV;
+    if (std::strcmp(env, "bin") == 0)
+        return TRACE_BINARY;
+    return TRACE_OFF;
+}
+
+// Estado tras `generation` generaciones completas de una ejecución
+struct TraceRecord
+{
+    std::uint32_t runId;
+    std::uint32_t island;
+    std::uint64_t popSize;
+    double crossoverRate;
+    std::int64_t started;
+    std::uint64_t generation;
+    std::uint64_t evaluations;
+    double seconds;
+    double bestFitness;
+    double meanFitness;
+    double worstFitness;
+    double bestRaw;
+};
+
+// Cabecera de los ficheros .bin (una vez, al crearlos)
+struct TraceFileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t recordBytes;
+};
+
+static constexpr char TRACE_MAGIC[8] = {'P', 'E', 'O', 'T', 'R', 'Z', '\0', '\0'};
+
+// ----------------------------------------------------
+// Cola SPSC acotada de registros (capacidad potencia de dos)
+// ----------------------------------------------------
+template <class T>
+class TraceRing
+{
+public:
+    explicit TraceRing(std::size_t capacity) : buf(capacity), mask(capacity - 1) {}
+
+    // Productor: false (y el registro se pierde) si la cola está llena
+    bool push(const T &v)
+    {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == buf.size())
+            return false;
+        buf[t & mask] = v;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor: false si está vacía
+    bool pop(T &v)
+    {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+            return false;
+        v = buf[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::vector<T> buf;
+    std::size_t mask;
+    alignas(64) std::atomic<std::size_t> head{0};
+    alignas(64) std::atomic<std::size_t> tail{0};
+};
+
+// ----------------------------------------------------
+// Escritor de la traza de un problema
+// ----------------------------------------------------
+class TraceWriter
+{
+public:
+    // Registros en vuelo como máximo (unos 1,4 MB)
+    static constexpr std::size_t RING_CAPACITY = 1 << 14;
+
+    explicit TraceWriter(const std::string &problem, TraceFormat format = traceFormatRequested())
+        : format(format)
+    {
+        if (format == TRACE_OFF)
+            return;
+        fileName = "traza_" + problem + "_" + hostName() + (format == TRACE_CSV ? ".csv" : ".bin");
+        fd = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0)
+        {
+            std::cerr << "Traza: no se puede abrir " << fileName << ": " << std::strerror(errno) << std::endl;
+            return;
+        }
+        // Con el fichero bloqueado entre la comprobación del tamaño y la cabecera: varios
+        // procesos que lo abren a la vez la escriben una sola vez
+        ::flock(fd, LOCK_EX);
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size == 0)
+            writeFileHeader();
+        ::flock(fd, LOCK_UN);
+        ring.reset(new TraceRing<TraceRecord>(RING_CAPACITY));
+        writer = std::thread([this]
+                             { drain(); });
+    }
+
+    ~TraceWriter()
+    {
+        if (writer.joinable())
+        {
+            stopping.store(true, std::memory_order_release);
+            writer.join();
+        }
+        if (fd >= 0)
+            ::close(fd);
+        if (dropped > 0)
+            std::cerr << "Traza: " << dropped << " registros descartados (escritor saturado)" << std::endl;
+    }
+
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter &operator=(const TraceWriter &) = delete;
+
+    bool enabled() const { return ring != nullptr; }
+
+    // Ejecución a la que pertenecen los registros siguientes
+    void begin(const GaConfig &cfg, unsigned island = 0)
+    {
+        current.runId = cfg.runId;
+        current.island = island;
+        current.popSize = cfg.popSize;
+        current.crossoverRate = cfg.crossoverRate;
+        current.started = std::int64_t(std::time(nullptr));
+    }
+
+    // Hilo del bucle: copia el estado r a la cola; nunca espera
+    void record(const GaResult &r)
+    {
+        if (!ring)
+            return;
+        TraceRecord rec = current;
+        rec.generation = r.generations;
+        rec.evaluations = r.evaluations;
+        rec.seconds = r.seconds;
+        rec.bestFitness = r.bestFitness;
+        rec.meanFitness = r.meanFitness;
+        rec.worstFitness = r.worstFitness;
+        rec.bestRaw = r.bestRaw;
+        if (!ring->push(rec))
+            ++dropped;
+    }
+
+private:
+    void writeFileHeader()
+    {
+        if (format == TRACE_CSV)
+        {
+            static const char header[] = "run,isla,poblacion,cruce,inicio,generacion,evaluaciones,tiempo,"
+                                         "fitness_mejor,fitness_medio,fitness_peor,valor_mejor\n";
+            writeAll(header, sizeof(header) - 1);
+        }
+        else
+        {
+            TraceFileHeader h;
+            std::memcpy(h.magic, TRACE_MAGIC, sizeof(h.magic));
+            h.version = 1;
+            h.recordBytes = sizeof(TraceRecord);
+            writeAll(reinterpret_cast<const char *>(&h), sizeof(h));
+        }
+    }
+
+    // Hilo escritor: vacía la cola cada milisegundo hasta que se pide parar y ya no queda nada
+    void drain()
+    {
+        std::vector<char> out;
+        out.reserve(1 << 16);
+        TraceRecord rec;
+        while (true)
+        {
+            bool last = stopping.load(std::memory_order_acquire);
+            while (ring->pop(rec))
+            {
+                append(out, rec);
+                if (out.size() >= (1 << 16))
+                {
+                    writeAll(out.data(), out.size());
+                    out.clear();
+                }
+            }
+            if (!out.empty())
+            {
+                writeAll(out.data(), out.size());
+                out.clear();
+            }
+            if (last)
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    void append(std::vector<char> &out, const TraceRecord &r) const
+    {
+        if (format == TRACE_BINARY)
+        {
+            const char *p = reinterpret_cast<const char *>(&r);
+            out.insert(out.end(), p, p + sizeof(r));
+            return;
+        }
+        char line[320];
+        int len = std::snprintf(line, sizeof(line), "%u,%u,%llu,%.10g,%lld,%llu,%llu,%.6f,%.10g,%.10g,%.10g,%.10g\n",
+                                r.runId, r.island, (unsigned long long)r.popSize, r.crossoverRate,
+                                (long long)r.started, (unsigned long long)r.generation,
+                                (unsigned long long)r.evaluations, r.seconds, r.bestFitness, r.meanFitness,
+                                r.worstFitness, r.bestRaw);
+        if (len > 0)
+            out.insert(out.end(), line, line + std::min<std::size_t>(std::size_t(len), sizeof(line) - 1));
+    }
+
+    void writeAll(const char *p, std::size_t n)
+    {
+        while (n > 0)
+        {
+            ssize_t w = ::write(fd, p, n);
+            if (w <= 0)
+                return;
+            p += w;
+            n -= std::size_t(w);
+        }
+    }
+
+    TraceFormat format;
+    std::string fileName;
+    int fd = -1;
+    std::unique_ptr<TraceRing<TraceRecord>> ring;
+    std::thread writer;
+    std::atomic<bool> stopping{false};
+    TraceRecord current = TraceRecord();
+    std::uint64_t dropped = 0;
+};